@@ -0,0 +1,412 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+#include <type_traits> // std::is_same
+#include <utility>  // std::move
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+// A hook is any class type callable without arguments. The default
+// `NoRollover` does nothing and is detected at compile time, so that
+// counters and clocks without subscribers generate exactly the same
+// code as in Step 12. Hook types are inherited privately (instead of
+// being stored as data members) to make the empty default occupy no
+// storage (aka "Empty Base Optimization").
+
+struct NoRollover {
+    void operator()() const {/*empty*/}
+};
+
+template<typename Hook>
+constexpr bool is_hooked = !std::is_same<Hook, NoRollover>::value;
+
+template<typename OnRollover = NoRollover>
+class ChainableDownCounter : public BaseDownCounter,
+                             private OnRollover {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next,
+                         OnRollover on_rollover = {})
+        : BaseDownCounter{limit}, OnRollover{std::move(on_rollover)},
+          next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+        if constexpr (is_hooked<OnRollover>)
+            OnRollover::operator()();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+// The hooks of `BasicClock` are called
+// - `OnSecond` when the 1/10-th seconds roll over (and hence borrow
+//   from the seconds),
+// - `OnMinute` when the seconds roll over (and hence borrow from the
+//   minutes),
+// - `OnZero` when the clock finally stops counting.
+// Note that hooks run synchronously from within the step, ie. in case
+// of a `ClockWork` they run in the clockwork thread.
+
+template<typename OnSecond = NoRollover,
+         typename OnMinute = NoRollover,
+         typename OnZero = NoRollover>
+class BasicClock : private OnZero {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter<OnMinute> seconds_;
+    ChainableDownCounter<OnSecond> tenthsecs_;
+public:
+    BasicClock(OnSecond on_second = {},
+               OnMinute on_minute = {},
+               OnZero on_zero = {})
+        : OnZero{std::move(on_zero)},
+          seconds_{60, minutes_, std::move(on_minute)},
+          tenthsecs_{10, seconds_, std::move(on_second)}
+    {/*empty*/}
+    BasicClock(const BasicClock&)            =delete; // Copy-C'tor
+    BasicClock(BasicClock&&)                 =delete; // Move-C'tor
+    BasicClock& operator=(const BasicClock&) =delete; // Copy-Assign
+    BasicClock& operator=(BasicClock&&)      =delete; // Move-Assign
+    ~BasicClock() =default;
+
+    void set(int);
+    operator bool() const;
+    BasicClock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+using Clock = BasicClock<>;
+
+template<typename S, typename M, typename Z>
+void BasicClock<S, M, Z>::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+template<typename S, typename M, typename Z>
+BasicClock<S, M, Z>::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+template<typename S, typename M, typename Z>
+BasicClock<S, M, Z>& BasicClock<S, M, Z>::operator--() {
+    if constexpr (is_hooked<Z>) {
+        if (!tenthsecs_.is_counting())
+            return *this;
+        tenthsecs_.step();
+        if (!tenthsecs_.is_counting())
+            Z::operator()();
+    }
+    else
+        tenthsecs_.step();
+    return *this;
+}
+
+template<typename S, typename M, typename Z>
+void BasicClock<S, M, Z>::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+template<typename S, typename M, typename Z>
+std::ostream& operator<<(std::ostream& lhs, const BasicClock<S, M, Z>& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+template<typename S, typename M, typename Z>
+bool BasicClock<S, M, Z>::operator-=(int steps) {
+    while (steps > 0) {
+        if (!this->operator bool())
+            return false;
+        --*this;
+        --steps;
+    }
+    return true;
+}
+
+#if 1
+
+#include <cassert>
+#include <sstream>
+
+void test_no_hooks_are_free() {
+    // an unhooked counter must not be larger than in Step 12
+    struct Step12_Chainable : BaseDownCounter {
+        I_DownCounting* next_; // (same size as a reference)
+    };
+    static_assert(sizeof(ChainableDownCounter<>)
+               == sizeof(Step12_Chainable), "unused hook takes space");
+    Clock c{};
+    c.set(12);
+    c -= 5;
+    std::ostringstream oss{};
+    oss << c;
+    assert(oss.str() == "  0:00.7");
+}
+
+void test_chained_rollover() {
+    int rollovers{};
+    auto count_rollovers = [&rollovers]{ ++rollovers; };
+    BaseDownCounter c0{3};
+    ChainableDownCounter c1{2, c0, count_rollovers};
+    c0.set(2);
+    c1.step();  assert(c1.get() == 1); assert(rollovers == 1);
+    c1.step();  assert(c1.get() == 0); assert(rollovers == 1);
+    c1.step();  assert(c1.get() == 1); assert(rollovers == 2);
+    c1.step();  assert(c1.get() == 0); assert(rollovers == 2);
+    c1.step();  assert(c1.get() == 0); assert(rollovers == 2);
+}
+
+void test_clock_hooks() {
+    int seconds{}, minutes{}, zeros{};
+    BasicClock clk{[&seconds]{ ++seconds; },
+                   [&minutes]{ ++minutes; },
+                   [&zeros]{ ++zeros; }};
+    clk.set(2*60*10 + 5);   // 2:00.5
+    clk -= 5;               // 2:00.0
+    assert(seconds == 0); assert(minutes == 0);
+    clk -= 1;               // 1:59.9
+    assert(seconds == 1); assert(minutes == 1);
+    clk -= 10;              // 1:58.9
+    assert(seconds == 2); assert(minutes == 1);
+    clk -= 60*10;           // 0:58.9
+    assert(seconds == 62); assert(minutes == 2);
+    assert(zeros == 0);
+    bool still_counting = (clk -= 589); // 0:00.0
+    assert(still_counting); assert(zeros == 1);
+    still_counting = (clk -= 1);
+    assert(!still_counting);
+    --clk;
+    assert(zeros == 1);
+    assert(seconds == 120); assert(minutes == 2);
+}
+
+int main()
+{
+    test_no_hooks_are_free();
+    test_chained_rollover();
+    test_clock_hooks();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+void runChessClock(std::ostream& clkout)
+{
+    Clock blackPlayerClock{};
+    Clock whitePlayerClock{};
+    auto theGameState{GameState::Initial};
+
+    auto showGameState = [&]{
+        clkout << "B:" << blackPlayerClock
+                    << ((theGameState == GameState::BlackDraw) ? "*" : " ")
+                    << "| "
+                    << "W:" << whitePlayerClock
+                    << ((theGameState == GameState::WhiteDraw) ? "*" : " ")
+                    << std::endl;
+        switch (theGameState) {
+        case GameState::BlackWins:
+            clkout << "!! Black Player Won !!" << std::endl;
+            break;
+        case GameState::WhiteWins:
+            std::cout << "!! White Player Won !!" << std::endl;
+            break;
+        default: ;//avoid warning
+        }
+    };
+    char command;
+    while (std::cin.get(command)) {
+        command = std::tolower(command);
+        if (std::islower(command)
+         || std::isdigit(command)
+         || (command == '?')
+         || (command == '.'))  {
+            std::cout << "===> " << command << std::endl;
+            int ticksToSimulate{};
+            switch(command) {
+                case 'r':
+                    if (not (theGameState == GameState::Initial
+                          || theGameState == GameState::BlackWins
+                          || theGameState == GameState::WhiteWins
+                          || theGameState == GameState::BlackPaused
+                          || theGameState == GameState::WhitePaused))
+                          continue;
+                    blackPlayerClock.set(InitialTime);
+                    whitePlayerClock.set(InitialTime);
+                    theGameState = GameState::Startable;
+                    break;
+                case 's': // start clock (white draws first)
+                    if (not (theGameState == GameState::Startable))
+                        continue;
+                    theGameState = GameState::WhiteDraw;
+                    break;
+                case 'p':
+                    if (not (theGameState == GameState::BlackDraw
+                          || theGameState == GameState::WhiteDraw))
+                        continue;
+                    switch (theGameState) {
+                    case GameState::BlackDraw:
+                        theGameState = GameState::BlackPaused;
+                        break;
+                    case GameState::WhiteDraw:
+                        theGameState = GameState::WhitePaused;
+                        break;
+                    default: ;//avoid warning
+                    }
+                    break;
+                case 'c': // coninue game
+                    if (not (theGameState == GameState::BlackPaused
+                          || theGameState == GameState::WhitePaused))
+                        continue;
+                    switch (theGameState) {
+                    case GameState::BlackPaused:
+                        theGameState = GameState::BlackDraw;
+                        break;
+                    case GameState::WhitePaused:
+                        theGameState = GameState::WhiteDraw;
+                        break;
+                    default: ;//avoid warning
+                    }
+                    break;
+                case 'x':
+                    if (not (theGameState == GameState::BlackDraw
+                          || theGameState == GameState::WhiteDraw))
+                        continue;
+                    switch (theGameState) {
+                    case GameState::BlackDraw:
+                        theGameState = GameState::WhiteDraw;
+                        break;
+                    case GameState::WhiteDraw:
+                        theGameState = GameState::BlackDraw;
+                        break;
+                    default: ;//avoid warning
+                    }
+                    break;
+                case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+                case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+                case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+                case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+                case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+                case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+                case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+                case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+                case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+                case '0':
+                    switch (theGameState) {
+                    case GameState::BlackDraw:
+                        blackPlayerClock -= ticksToSimulate;
+                        if (!blackPlayerClock)
+                            theGameState = GameState::WhiteWins;
+                        break;
+                    case GameState::WhiteDraw:
+                        whitePlayerClock -= ticksToSimulate;
+                        if (!whitePlayerClock)
+                            theGameState = GameState::BlackWins;
+                        break;
+                    default:
+                        continue;
+                    }
+                    break;
+                case '?':
+                    std::cout << "*** Chess Clock Commands ***\n"
+                                 "r - reset player clocks to initial time\n"
+                                 "s - start the game (white draws first)\n"
+                                 "p - pause the game\n"
+                                 "c - continue the game\n"
+                                 "--- General Commends ---\n"
+                                 "? - show this list of commands\n"
+                                 ". - end the chess clock program\n";
+                    break;
+                case '.':
+                    std::cout << "Thanks for using the Chess-Clock" << std::endl;
+                    return;
+            }
+            showGameState();
+        }
+    }
+}
+
+#include <fstream>
+#include <string>
+int main(int argc, char *argv[])
+{
+    std::ofstream clock_display{};
+    if ((argc == 2)
+     && std::string{argv[1]}.find("/dev/tty") == 0) {
+        clock_display.open(argv[1]);
+        if (clock_display) {
+            std::cout << "CLOCK DISPLAY: " << argv[1] << std::endl;
+            clock_display << "*** CHESS CLOCK DISPLAY ***\n";
+        }
+    }
+    runChessClock(clock_display.is_open() ? clock_display : std::cout);
+}
+
+#endif
@@ -0,0 +1,683 @@
+#include <chrono>   // std::chrono::steady_clock
+#include <cstdint>  // std::int64_t
+                    // std::uint64_t
+#include <cstdlib>  // std::atol
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <sstream>  // std::ostringstream
+#include <string>   // std::string
+                    // std::to_string
+
+// This sideline puts the five different designs of class `Clock` as
+// they were developed from Step 1 to Step 12 side by side and runs the
+// same workloads against each of them. To keep them apart each design
+// lives in its own namespace; the code is copied from the
+// respective step (leaving out the parts not required here).
+
+constexpr int MaxTime{1000*60*10 - 1}; // 999:59.9
+
+namespace plain_int { // Step 01 to Step 07
+
+class Clock {
+private:
+    int tenthSeconds_{0};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    auto set(int ts) {
+        tenthSeconds_ = ts;
+    }
+    auto get() const {
+        return tenthSeconds_;
+    }
+    explicit operator bool() const {
+        return (tenthSeconds_ > 0);
+    }
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+Clock& Clock::operator--() {
+    if (tenthSeconds_ > 0)
+        --tenthSeconds_;
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto ts = tenthSeconds_;
+    const auto t{ts % 10}; ts /= 10;
+    const auto s{ts % 60}; ts /= 60;
+    std::string result{};
+    result += std::to_string(ts);
+    result += ':';
+    if (s < 10) result += '0';
+    result += std::to_string(s);
+    result += '.';
+    result += std::to_string(t);
+    os << result;
+}
+
+bool Clock::operator-=(int steps) {
+    while (steps > 0) {
+        if (!this->operator bool())
+            return false;
+        --*this;
+        --steps;
+    }
+    return true;
+}
+
+} // namespace plain_int
+
+namespace pointer_chain { // Step 08
+
+class DownCounter {
+    int value_{};
+    const int reset_{};
+    DownCounter* next_{};
+public:
+    DownCounter() =default;
+    DownCounter(int reset, DownCounter* next = nullptr)
+        : reset_{reset}, next_{next}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const;
+    void step();
+};
+
+void DownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool DownCounter::is_counting() const {
+     return (value_ != 0)
+         || (next_ && next_->is_counting());
+}
+
+void DownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (next_ && next_->is_counting()) {
+            next_->step();
+            value_ = reset_-1;
+        }
+    }
+}
+
+class Clock {
+private:
+    DownCounter minutes_{1000};
+    DownCounter seconds_{60, &minutes_};
+    DownCounter tenthsecs_{10, &seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    explicit operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+bool Clock::operator-=(int steps) {
+    while (steps > 0) {
+        if (!this->operator bool())
+            return false;
+        --*this;
+        --steps;
+    }
+    return true;
+}
+
+} // namespace pointer_chain
+
+namespace virtual_chain { // Step 09
+
+class BaseDownCounter {
+protected:
+    int value_{};
+    const int reset_{};
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    virtual bool is_counting() const;
+    virtual void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0);
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    BaseDownCounter& next_;
+public:
+    ChainableDownCounter(int limit, BaseDownCounter& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    bool is_counting() const override {
+        return (value_ > 0)
+            || next_.is_counting();
+    }
+    void step() override;
+};
+
+void ChainableDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (next_.is_counting()) {
+            next_.step();
+            value_ = reset_-1;
+        }
+    }
+}
+
+} // namespace virtual_chain
+
+namespace nvi_chain { // Step 10
+
+class BaseDownCounter {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    BaseDownCounter& next_;
+public:
+    ChainableDownCounter(int limit, BaseDownCounter& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+} // namespace nvi_chain
+
+namespace interface_chain { // Step 11 and Step 12
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+} // namespace interface_chain
+
+// The designs from Step 09 to Step 12 only differ in their counters,
+// the class `Clock` on top of them is the same in all these steps.
+
+template<typename BaseDownCounter, typename ChainableDownCounter>
+class ChainedClock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    ChainedClock() =default;
+    ChainedClock(const ChainedClock&)            =delete;
+    ChainedClock(ChainedClock&&)                 =delete;
+    ChainedClock& operator=(const ChainedClock&) =delete;
+    ChainedClock& operator=(ChainedClock&&)      =delete;
+    ~ChainedClock() =default;
+
+    void set(int ts) {
+        tenthsecs_.set(ts % 10); ts /= 10;
+        seconds_.set(ts % 60); ts /= 60;
+        minutes_.set(ts);
+    }
+    explicit operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+    ChainedClock& operator--() {
+        tenthsecs_.step();
+        return *this;
+    }
+    bool operator-=(int steps) {
+        while (steps > 0) {
+            if (!this->operator bool())
+                return false;
+            --*this;
+            --steps;
+        }
+        return true;
+    }
+    void show(std::ostream& os = std::cout) const {
+        auto const saved_fill{os.fill()};
+        using std::setw;
+        using std::setfill;
+        os << setfill(' ') << setw(3) << minutes_.get() << ':'
+           << setfill('0') << setw(2) << seconds_.get() << '.'
+                           << setw(1) << tenthsecs_.get();
+        os.fill(saved_fill);
+    }
+};
+
+namespace virtual_chain {
+    using Clock = ChainedClock<BaseDownCounter, ChainableDownCounter>;
+}
+namespace nvi_chain {
+    using Clock = ChainedClock<BaseDownCounter, ChainableDownCounter>;
+}
+namespace interface_chain {
+    using Clock = ChainedClock<BaseDownCounter, ChainableDownCounter>;
+}
+
+// --------------------------------------------------------------------
+// Benchmark harness
+// --------------------------------------------------------------------
+
+#include <linux/perf_event.h>   // perf_event_attr
+                                // PERF_*
+#include <sys/ioctl.h>          // ioctl
+#include <sys/syscall.h>        // SYS_perf_event_open
+#include <unistd.h>             // syscall
+                                // read
+                                // close
+#include <array>                // std::array
+#include <vector>               // std::vector
+
+// Counts a group of hardware events of the calling thread (user space
+// only) with Linux' `perf_event_open`. All events which could be opened
+// are scheduled together so that their counts refer to exactly the
+// same instructions. Events which are not available (eg. in a container
+// or with `perf_event_paranoid` set too restrictive, or an L1 event the
+// CPU does not support) silently report "no value"; if none of them is
+// available only times are measured.
+
+class PerfCounters {
+public:
+    enum Event { Cycles, Instructions, L1D_Misses, BranchMisses, NrEvents };
+    static constexpr std::array<const char*, NrEvents> names{
+        "cycles", "instructions", "l1d_misses", "branch_misses"
+    };
+    using Counts = std::array<double, NrEvents>; // negative: no value
+private:
+    std::array<int, NrEvents> fd_{-1, -1, -1, -1};
+    std::array<int, NrEvents> slot_{}; // position in group read
+    int leader_{-1};
+    int nr_open_{};
+    static int open_event(std::uint32_t type, std::uint64_t config,
+                          int group_fd) {
+        perf_event_attr attr{};
+        attr.type = type;
+        attr.size = sizeof attr;
+        attr.config = config;
+        attr.disabled = (group_fd == -1); // (leader controls the group)
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP
+                         | PERF_FORMAT_TOTAL_TIME_ENABLED
+                         | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(::syscall(SYS_perf_event_open,
+                                          &attr, 0, -1, group_fd, 0));
+    }
+public:
+    PerfCounters() {
+        struct { std::uint32_t type; std::uint64_t config; }
+        const events[NrEvents]{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                               | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                               | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        };
+        for (int e{}; e < NrEvents; ++e) {
+            fd_[e] = open_event(events[e].type, events[e].config, leader_);
+            if (fd_[e] == -1)
+                continue;
+            if (leader_ == -1)
+                leader_ = fd_[e];
+            slot_[e] = nr_open_++;
+        }
+    }
+    PerfCounters(const PerfCounters&)            =delete;
+    PerfCounters& operator=(const PerfCounters&) =delete;
+    ~PerfCounters() {
+        for (auto fd : fd_)
+            if (fd != -1) ::close(fd);
+    }
+
+    bool available() const { return leader_ != -1; }
+    void start() {
+        if (leader_ == -1) return;
+        ::ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ::ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    Counts stop() {
+        Counts result{-1, -1, -1, -1};
+        if (leader_ == -1) return result;
+        ::ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        // layout of `read` with PERF_FORMAT_GROUP (see perf_event_open(2))
+        std::uint64_t data[3 + NrEvents]{};
+        if (::read(leader_, data, sizeof data) <= 0)
+            return result;
+        auto const time_enabled{data[1]};
+        auto const time_running{data[2]};
+        if (time_running == 0)
+            return result; // (never got a hardware counter slot)
+        // extrapolate if the kernel had to multiplex the counters
+        auto const scale{static_cast<double>(time_enabled) / time_running};
+        for (int e{}; e < NrEvents; ++e)
+            if (fd_[e] != -1)
+                result[e] = data[3 + slot_[e]] * scale;
+        return result;
+    }
+};
+
+// keeps the compiler from optimizing away (or hoisting out of the
+// loop) accesses to an object it could otherwise prove unused
+template<typename T>
+inline void do_not_optimize(T& object) {
+    asm volatile("" : : "g"(&object) : "memory");
+}
+
+class Benchmark {
+    struct Result {
+        std::string design;
+        std::string workload;
+        long ops;
+        double ns;
+        PerfCounters::Counts counts;
+    };
+    PerfCounters perf_{};
+    std::vector<Result> results_{};
+    long ops_{};
+public:
+    explicit Benchmark(long ops) : ops_{ops} {}
+    // `body(n)` has to run the workload `n` times
+    template<typename Body>
+    void run(const char* design, const char* workload,
+             long ops_scale, Body body) {
+        auto const ops{ops_ / ops_scale};
+        body(ops/10); // warm up caches and branch predictors
+        using std::chrono::steady_clock;
+        perf_.start();
+        auto const t0{steady_clock::now()};
+        body(ops);
+        auto const t1{steady_clock::now()};
+        auto const counts{perf_.stop()};
+        std::chrono::duration<double, std::nano> const elapsed{t1 - t0};
+        results_.push_back({design, workload, ops, elapsed.count(), counts});
+    }
+    void report_table(std::ostream&) const;
+    void report_json(std::ostream&) const;
+};
+
+void Benchmark::report_table(std::ostream& os) const {
+    using std::setw;
+    os << std::left  << setw(16) << "design" << setw(16) << "workload"
+       << std::right << setw(10) << "ns/op";
+    for (auto name : PerfCounters::names)
+        os << setw(15) << name;
+    os << "  (per op)\n";
+    auto const saved_precision{os.precision(2)};
+    os << std::fixed;
+    for (auto const& r : results_) {
+        os << std::left  << setw(16) << r.design << setw(16) << r.workload
+           << std::right << setw(10) << r.ns / r.ops;
+        for (auto count : r.counts) {
+            os << setw(15);
+            if (count < 0)
+                os << "n/a";
+            else
+                os << count / r.ops;
+        }
+        os << '\n';
+    }
+    os << std::defaultfloat << std::flush;
+    os.precision(saved_precision);
+}
+
+void Benchmark::report_json(std::ostream& os) const {
+    auto const saved_precision{os.precision(4)};
+    os << "{\n"
+          "  \"perf_counters\": " << (perf_.available() ? "true" : "false")
+       << ",\n"
+          "  \"results\": [";
+    const char* separator{"\n"};
+    for (auto const& r : results_) {
+        os << separator
+           << "    {\"design\": \"" << r.design << "\", "
+              "\"workload\": \"" << r.workload << "\", "
+              "\"ops\": " << r.ops << ", "
+              "\"ns_per_op\": " << r.ns / r.ops;
+        for (int e{}; e < PerfCounters::NrEvents; ++e) {
+            os << ", \"" << PerfCounters::names[e] << "_per_op\": ";
+            if (r.counts[e] < 0)
+                os << "null";
+            else
+                os << r.counts[e] / r.ops;
+        }
+        os << '}';
+        separator = ",\n";
+    }
+    os << "\n  ]\n"
+          "}" << std::endl;
+    os.precision(saved_precision);
+}
+
+template<typename Clock>
+void benchmark_design(Benchmark& bm, const char* design) {
+    Clock clk{};
+
+    clk.set(MaxTime);
+    bm.run(design, "single step", 1, [&clk](long n) {
+        while (n-- > 0) {
+            if (!clk)
+                clk.set(MaxTime);
+            --clk;
+            do_not_optimize(clk);
+        }
+    });
+
+    clk.set(MaxTime);
+    bm.run(design, "subtract 600", 100, [&clk](long n) {
+        while (n-- > 0) {
+            if (!(clk -= 600))
+                clk.set(MaxTime);
+            do_not_optimize(clk);
+        }
+    });
+
+    bm.run(design, "set", 1, [&clk](long n) {
+        for (int ts{}; n-- > 0; ts = (ts < MaxTime) ? ts+7 : 0) {
+            clk.set(ts);
+            do_not_optimize(clk);
+        }
+    });
+
+    std::ostringstream oss{};
+    clk.set(12*60*10 + 34*10 + 5);
+    bm.run(design, "show", 20, [&clk, &oss](long n) {
+        while (n-- > 0) {
+            oss.seekp(0);
+            clk.show(oss);
+            do_not_optimize(oss);
+        }
+    });
+
+    clk.set(MaxTime);
+    bm.run(design, "is_counting", 1, [&clk](long n) {
+        bool counting{};
+        while (n-- > 0) {
+            do_not_optimize(clk);
+            counting = static_cast<bool>(clk);
+            do_not_optimize(counting);
+        }
+    });
+}
+
+// Usage: Step_12b [--json] [operations]
+// (compile with optimization, eg. `g++ -std=c++17 -O2 Step_12b.cpp`)
+
+int main(int argc, char* argv[]) {
+    long ops{10'000'000};
+    bool json{};
+    for (int i{1}; i < argc; ++i) {
+        if (std::string{argv[i]} == "--json")
+            json = true;
+        else
+            ops = std::atol(argv[i]);
+    }
+    if (ops < 1'000) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--json] [operations >= 1000]\n";
+        return 1;
+    }
+    Benchmark bm{ops};
+    benchmark_design<plain_int::Clock>(bm, "plain int");
+    benchmark_design<pointer_chain::Clock>(bm, "pointer chain");
+    benchmark_design<virtual_chain::Clock>(bm, "virtual");
+    benchmark_design<nvi_chain::Clock>(bm, "NVI");
+    benchmark_design<interface_chain::Clock>(bm, "I_DownCounting");
+    if (json)
+        bm.report_json(std::cout);
+    else
+        bm.report_table(std::cout);
+}
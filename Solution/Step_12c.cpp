@@ -0,0 +1,333 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+bool Clock::operator-=(int steps) {
+    while (steps > 0) {
+        if (!this->operator bool())
+            return false;
+        --*this;
+        --steps;
+    }
+    return true;
+}
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <thread>
+
+// The clockwork of Step 12 was hard-wired to real time. To run it
+// faster than real time (eg. in regression tests of complete games)
+// the time source is now injected through an interface, similar to
+// `I_DownCounting` above. Whatever time source is used, the clockwork
+// and its subscriber run exactly the same code.
+
+class I_TimeSource {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    virtual time_point now() const =0;
+    virtual void sleep_until(time_point) =0;
+};
+
+class SteadyTimeSource : public I_TimeSource {
+public:
+    time_point now() const override {
+        return std::chrono::steady_clock::now();
+    }
+    void sleep_until(time_point t) override {
+        std::this_thread::sleep_until(t);
+    }
+};
+
+// Virtual time only advances when the clockwork sleeps, so that runs
+// are fully deterministic. With a `speedup` of zero a sleep returns at
+// once, otherwise virtual time is mapped to real time divided by
+// `speedup` (eg. 10'000 runs a 30 minute game in 0.18 seconds). As the
+// mapping is absolute, oversleeping in one tick is caught up in the
+// next ones.
+
+class SimulatedTimeSource : public I_TimeSource {
+    std::atomic<time_point::rep> now_{}; // (read by other threads)
+    const double speedup_{};
+    const time_point real_start_{std::chrono::steady_clock::now()};
+public:
+    explicit SimulatedTimeSource(double speedup = 0.0)
+        : speedup_{speedup}
+    {/*empty*/}
+    time_point now() const override {
+        return time_point{time_point::duration{now_.load()}};
+    }
+    void sleep_until(time_point t) override {
+        if (t <= now())
+            return;
+        if (speedup_ > 0.0)
+            std::this_thread::sleep_until(real_start_
+                + std::chrono::duration_cast<time_point::duration>(
+                        t.time_since_epoch() / speedup_));
+        now_.store(t.time_since_epoch().count());
+    }
+};
+
+I_TimeSource& steady_time_source() {
+    static SteadyTimeSource instance{};
+    return instance;
+}
+
+// Compared to Step 12 the clockwork now
+// - sleeps until an absolute deadline, so that the tick period does
+//   not drift by the time the subscriber takes,
+// - calls the subscriber after (not before) the first period passed,
+// - uses an atomic flag to be stopped from another thread.
+
+class ClockWork {
+    I_TimeSource& time_;
+    const std::chrono::nanoseconds period_;
+    std::atomic<bool> stopping_{};
+    std::function<void()> subscriber_{};
+    std::thread cw_thread_{};
+public:
+    explicit ClockWork(I_TimeSource& time_source = steady_time_source(),
+                       std::chrono::nanoseconds period
+                            = std::chrono::milliseconds{100})
+        : time_{time_source}, period_{period}
+    {/*empty*/}
+    auto start() {
+        std::cout << "--- clockwork will be started" << std::endl;
+        cw_thread_ = std::thread{[this]{
+                auto next_tick{time_.now()};
+                while (!stopping_) {
+                    next_tick += period_;
+                    time_.sleep_until(next_tick);
+                    if (subscriber_)
+                        subscriber_();
+                }
+            }
+        };
+        std::cout << "--- clockwork thread running" << std::endl;
+    }
+    auto stop() {
+        std::cout << "--- clockwork will be stopped" << std::endl;
+        stopping_ = true;
+        if (cw_thread_.joinable())
+            cw_thread_.join();
+        std::cout << "--- clockwork thread ended" << std::endl;
+        stopping_ = false;
+    }
+    void attach(std::function<void()> subscriber) {
+        subscriber_ = subscriber;
+        std::cout << "--- subscriber "
+                  << (subscriber_ ? "attached to"
+                                  : "detached from")
+                  << " clockwork" << std::endl;
+    }
+};
+
+#include <cassert>
+
+// Runs a player clock from `InitialTime` down to zero through the
+// clockwork and returns the (virtual) time it took.
+
+std::chrono::nanoseconds run_full_game(I_TimeSource& time_source,
+                                       int& ticks) {
+    ClockWork cw{time_source};
+    Clock playerClock{};
+    playerClock.set(InitialTime);
+    ticks = 0;
+    I_TimeSource::time_point flag_fell_at{};
+    std::promise<void> flag_fall{};
+    cw.attach([&]{
+        if (!playerClock)
+            return;
+        ++ticks;
+        --playerClock;
+        if (!playerClock) {
+            flag_fell_at = time_source.now();
+            flag_fall.set_value();
+        }
+    });
+    auto const started_at{time_source.now()};
+    cw.start();
+    flag_fall.get_future().wait();
+    cw.stop();
+    return flag_fell_at - started_at;
+}
+
+void test_instant_simulation() {
+    SimulatedTimeSource instant{};
+    int ticks{};
+    auto const game_time{run_full_game(instant, ticks)};
+    assert(ticks == InitialTime);
+    assert(game_time == std::chrono::minutes{30});
+}
+
+void test_accelerated_simulation() {
+    SimulatedTimeSource accelerated{10'000.0};
+    int ticks{};
+    auto const real_start{std::chrono::steady_clock::now()};
+    auto const game_time{run_full_game(accelerated, ticks)};
+    std::chrono::duration<double> const real_time{
+        std::chrono::steady_clock::now() - real_start
+    };
+    assert(ticks == InitialTime);
+    assert(game_time == std::chrono::minutes{30});
+    std::cout << "*** 30 minute game at 10'000x took "
+              << real_time.count() << " seconds" << std::endl;
+}
+
+#if 1
+
+int main() {
+    test_instant_simulation();
+    test_accelerated_simulation();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+int main() {
+    // same as in Step 12 but in real time
+    ClockWork cw{};
+    std::cout <<  "... hit return to start clockwork ";
+    std::cin.get();
+    cw.start();
+
+    std::cout << "... hit return to attach subscriber ";
+    std::cin.get();
+    int n{};
+    cw.attach([&n]{
+            std::cout << std::setw(3) << ++n
+                      << " hit return to detach subscriber "
+                      << std::endl;
+    });
+
+    std::cin.get();
+    cw.attach(nullptr);
+
+    std::cout << "... hit return to stop clockwork ";
+    std::cin.get();
+    cw.stop();
+
+    std::cout << "... hit return to end program";
+    std::cin.get();
+    std::cout << "*** goodbye\n";
+}
+
+#endif
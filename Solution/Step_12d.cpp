@@ -0,0 +1,464 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+void runChessClock(std::ostream& clkout)
+{
+    ChessClock chessClock{};
+    char command;
+    while (std::cin.get(command)) {
+        command = std::tolower(static_cast<unsigned char>(command));
+        if (is_command(command)) {
+            std::cout << "===> " << command << std::endl;
+            switch (command) {
+                case '?':
+                    std::cout << "*** Chess Clock Commands ***\n"
+                                 "r - reset player clocks to initial time\n"
+                                 "s - start the game (white draws first)\n"
+                                 "p - pause the game\n"
+                                 "c - continue the game\n"
+                                 "x - switch to the other player\n"
+                                 "0..9 - advance the active player clock\n"
+                                 "--- General Commends ---\n"
+                                 "? - show this list of commands\n"
+                                 ". - end the chess clock program\n";
+                    break;
+                case '.':
+                    std::cout << "Thanks for using the Chess-Clock" << std::endl;
+                    return;
+                default:
+                    if (!chessClock.process(command))
+                        continue;
+            }
+            chessClock.show(clkout);
+        }
+    }
+}
+
+#include <array>
+#include <chrono>
+#include <unistd.h> // read
+
+// The headless mode reads the commands in large blocks directly from
+// a file descriptor (bypassing `std::cin` and its per-character
+// overhead) and does not show anything for the individual commands.
+// Only the final state and some summary counters are reported.
+
+struct HeadlessSummary {
+    long long bytes{};
+    long long commands{};
+    long long ignored{};
+    long long whiteWins{};
+    long long blackWins{};
+    std::array<long long, 128> perCommand{};
+    void show(std::ostream&, std::chrono::duration<double>) const;
+};
+
+void HeadlessSummary::show(std::ostream& os,
+                           std::chrono::duration<double> elapsed) const {
+    os << "bytes read:         " << bytes << '\n'
+       << "commands processed: " << commands << '\n'
+       << "commands ignored:   " << ignored << '\n'
+       << "white player won:   " << whiteWins << '\n'
+       << "black player won:   " << blackWins << '\n'
+       << "commands by type:  ";
+    for (int c{}; c < static_cast<int>(perCommand.size()); ++c)
+        if (perCommand[c])
+            os << ' ' << static_cast<char>(c) << '=' << perCommand[c];
+    os << '\n'
+       << "elapsed seconds:    " << elapsed.count() << '\n'
+       << "commands/second:    " << commands / elapsed.count() << std::endl;
+}
+
+HeadlessSummary runHeadless(int fd, ChessClock& chessClock)
+{
+    HeadlessSummary summary{};
+    static char buffer[1<<16];
+    for (;;) {
+        auto const n{::read(fd, buffer, sizeof buffer)};
+        if (n <= 0)
+            return summary;
+        summary.bytes += n;
+        for (auto p{buffer}; p != buffer + n; ++p) {
+            char const command = std::tolower(static_cast<unsigned char>(*p));
+            if (!is_command(command))
+                continue;
+            ++summary.commands;
+            ++summary.perCommand[command];
+            if (command == '.')
+                return summary;
+            if (!chessClock.process(command)) {
+                ++summary.ignored;
+                continue;
+            }
+            switch (chessClock.state()) {
+            case GameState::WhiteWins: ++summary.whiteWins; break;
+            case GameState::BlackWins: ++summary.blackWins; break;
+            default: ;//avoid warning
+            }
+        }
+    }
+}
+
+#if 0
+
+#include <cassert>
+#include <sstream>
+
+void test_bulk_subtract() {
+    Clock clk{};
+    clk.set(601);                   assert(clk.get() == 601);
+    bool counting = (clk -= 0);     assert(counting); assert(clk.get() == 601);
+    counting = (clk -= 2);          assert(counting); assert(clk.get() == 599);
+    counting = (clk -= 599);        assert(counting); assert(clk.get() == 0);
+    counting = (clk -= 1);          assert(!counting); assert(clk.get() == 0);
+    clk.set(5);
+    counting = (clk -= 6);          assert(!counting); assert(clk.get() == 0);
+}
+
+void test_fsm() {
+    ChessClock cc{};
+    assert(!cc.process('s'));       assert(cc.state() == GameState::Initial);
+    assert(cc.process('r'));        assert(cc.state() == GameState::Startable);
+    assert(cc.process('s'));        assert(cc.state() == GameState::WhiteDraw);
+    assert(cc.process('x'));        assert(cc.state() == GameState::BlackDraw);
+    assert(cc.process('p'));        assert(cc.state() == GameState::BlackPaused);
+    assert(!cc.process('5'));       assert(cc.state() == GameState::BlackPaused);
+    assert(cc.process('c'));        assert(cc.state() == GameState::BlackDraw);
+    assert(cc.process('6'));        assert(cc.state() == GameState::BlackDraw);
+    assert(cc.process('7'));        assert(cc.state() == GameState::WhiteWins);
+    assert(!cc.process('x'));       assert(cc.state() == GameState::WhiteWins);
+    std::ostringstream oss{};
+    cc.show(oss);
+    assert(oss.str() == "B:  0:00.0 | W: 30:00.0 \n"
+                        "!! White Player Won !!\n");
+}
+
+int main() {
+    test_bulk_subtract();
+    test_fsm();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <fcntl.h>  // open
+#include <fstream>
+#include <string>
+
+// Usage: Step_12d [/dev/ttyX]              (interactive)
+//        Step_12d --headless [command-file] (batch, default is stdin)
+
+int main(int argc, char *argv[])
+{
+    if ((argc >= 2) && (std::string{argv[1]} == "--headless")) {
+        int fd{0};
+        if ((argc == 3)
+         && (fd = ::open(argv[2], O_RDONLY)) == -1) {
+            std::cerr << "cannot open: " << argv[2] << std::endl;
+            return 1;
+        }
+        ChessClock chessClock{};
+        using std::chrono::steady_clock;
+        auto const start{steady_clock::now()};
+        auto const summary{runHeadless(fd, chessClock)};
+        auto const elapsed{steady_clock::now() - start};
+        std::cout << "final state:        "
+                  << to_string(chessClock.state()) << '\n';
+        chessClock.show(std::cout);
+        summary.show(std::cout, elapsed);
+        return 0;
+    }
+    std::ofstream clock_display{};
+    if ((argc == 2)
+     && std::string{argv[1]}.find("/dev/tty") == 0) {
+        clock_display.open(argv[1]);
+        if (clock_display) {
+            std::cout << "CLOCK DISPLAY: " << argv[1] << std::endl;
+            clock_display << "*** CHESS CLOCK DISPLAY ***\n";
+        }
+    }
+    runChessClock(clock_display.is_open() ? clock_display : std::cout);
+}
+
+#endif
@@ -0,0 +1,545 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+// A transcript archive holds one game per line: the commands as read
+// by `runChessClock` (r, s, p, c, x, and digits), followed by `=` and
+// the recorded outcome, which is `W` (white player won), `B` (black
+// player won), or `-` (no winner), eg.
+//
+//      rs5x5x7x8=B
+//
+// Replaying a game starts with a fresh `ChessClock` and succeeds if
+// the final state matches the recorded outcome.
+
+char outcome(GameState state) {
+    switch (state) {
+    case GameState::WhiteWins: return 'W';
+    case GameState::BlackWins: return 'B';
+    default:                   return '-';
+    }
+}
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap
+                        // munmap
+                        // madvise
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+
+// Maps a file read-only into memory for as long as the object lives.
+
+class MappedFile {
+    const char* data_{};
+    std::size_t size_{};
+public:
+    explicit MappedFile(const char* path) {
+        int const fd{::open(path, O_RDONLY)};
+        if (fd == -1)
+            return;
+        struct stat st{};
+        if ((::fstat(fd, &st) == 0) && (st.st_size > 0)) {
+            void* const p{::mmap(nullptr, st.st_size, PROT_READ,
+                                 MAP_PRIVATE, fd, 0)};
+            if (p != MAP_FAILED) {
+                ::madvise(p, st.st_size, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(p);
+                size_ = st.st_size;
+            }
+        }
+        ::close(fd);
+    }
+    MappedFile(const MappedFile&)            =delete;
+    MappedFile& operator=(const MappedFile&) =delete;
+    ~MappedFile() {
+        if (data_)
+            ::munmap(const_cast<char*>(data_), size_);
+    }
+    explicit operator bool() const { return data_ != nullptr; }
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+};
+
+struct ReplaySummary {
+    long long games{};
+    long long commands{};
+    long long mismatches{};
+    const char* firstMismatch{}; // (start of game in mapped file)
+    void merge(const ReplaySummary& other) {
+        games += other.games;
+        commands += other.commands;
+        mismatches += other.mismatches;
+        if (other.firstMismatch
+         && (!firstMismatch || other.firstMismatch < firstMismatch))
+            firstMismatch = other.firstMismatch;
+    }
+};
+
+// Replays all games in [begin, end), which has to start at the
+// beginning of a game; nothing is allocated per game or per command.
+
+ReplaySummary replay(const char* begin, const char* end) {
+    ReplaySummary summary{};
+    auto p{begin};
+    while (p != end) {
+        auto const game{p};
+        ChessClock chessClock{};
+        while ((p != end) && (*p != '=') && (*p != '\n')) {
+            char const command = std::tolower(static_cast<unsigned char>(*p++));
+            if (std::islower(command) || std::isdigit(command)) {
+                ++summary.commands;
+                chessClock.process(command);
+            }
+        }
+        char recorded{};
+        if ((p != end) && (*p == '=') && (++p != end))
+            recorded = *p;
+        p = std::find(p, end, '\n');
+        if (p != end)
+            ++p;
+        if (*game == '\n')
+            continue; // (empty line)
+        ++summary.games;
+        if (outcome(chessClock.state()) != recorded) {
+            ++summary.mismatches;
+            if (!summary.firstMismatch)
+                summary.firstMismatch = game;
+        }
+    }
+    return summary;
+}
+
+// Splits the archive in (roughly) equal parts at line boundaries and
+// replays each part in a thread of its own.
+
+ReplaySummary replay_parallel(const char* begin, const char* end,
+                              unsigned threads) {
+    std::vector<const char*> bounds{begin};
+    for (unsigned t{1}; t < threads; ++t) {
+        auto split{begin + (end - begin) * t / threads};
+        split = std::max(split, bounds.back());
+        split = std::find(split, end, '\n');
+        bounds.push_back((split != end) ? split + 1 : end);
+    }
+    bounds.push_back(end);
+    std::vector<ReplaySummary> results(threads);
+    std::vector<std::thread> workers{};
+    for (unsigned t{}; t < threads; ++t)
+        workers.emplace_back([&results, &bounds, t]{
+            results[t] = replay(bounds[t], bounds[t+1]);
+        });
+    ReplaySummary summary{};
+    for (unsigned t{}; t < threads; ++t) {
+        workers[t].join();
+        summary.merge(results[t]);
+    }
+    return summary;
+}
+
+#include <fstream>
+#include <random>
+#include <string>
+
+// Writes an archive of random games with their outcomes as computed
+// by the current implementation (eg. as a reference for later ones).
+
+void generate(const char* path, long long games, unsigned seed) {
+    std::ofstream archive{path};
+    std::mt19937 rng{seed};
+    static const char alphabet[]{"rspcx0123456789"};
+    std::uniform_int_distribution<int> pick{0, sizeof alphabet - 2};
+    std::uniform_int_distribution<int> length{1, 200};
+    std::string game{};
+    while (games-- > 0) {
+        ChessClock chessClock{};
+        game.assign(1, 'r');
+        chessClock.process('r');
+        for (int n{length(rng)}; n > 0; --n) {
+            char const command{alphabet[pick(rng)]};
+            game += command;
+            chessClock.process(command);
+        }
+        game += '=';
+        game += outcome(chessClock.state());
+        game += '\n';
+        archive << game;
+    }
+}
+
+#if 0
+
+#include <cassert>
+
+void test_replay() {
+    std::string const archive{
+        "rs7x7x9=B\n"       // white loses
+        "rsx9=W\n"          // black loses
+        "rs5p5=-\n"         // paused, nobody won
+        "\n"                // (ignored)
+        "rs7x7x9=W\n"       // wrong outcome recorded
+        "rs"                // incomplete last line
+    };
+    auto const summary{replay(archive.data(),
+                              archive.data() + archive.size())};
+    assert(summary.games == 5);
+    assert(summary.mismatches == 2);
+    assert(summary.firstMismatch == archive.data() + 26);
+    assert(summary.commands == 7 + 4 + 5 + 7 + 2);
+    auto const parallel{replay_parallel(archive.data(),
+                                        archive.data() + archive.size(),
+                                        4)};
+    assert(parallel.games == summary.games);
+    assert(parallel.mismatches == summary.mismatches);
+    assert(parallel.firstMismatch == summary.firstMismatch);
+    assert(parallel.commands == summary.commands);
+}
+
+void test_replay_short_last_game() {
+    std::string const archive{
+        "rs9=B\n"
+        "r"                 // one command, no newline
+    };
+    auto const summary{replay(archive.data(),
+                              archive.data() + archive.size())};
+    assert(summary.games == 2);
+    assert(summary.mismatches == 1);
+    assert(summary.firstMismatch == archive.data() + 6);
+    assert(summary.commands == 3 + 1);
+}
+
+int main() {
+    test_replay();
+    test_replay_short_last_game();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+// Usage: Step_12e archive [threads]
+//        Step_12e --generate archive games [seed]
+
+int main(int argc, char* argv[]) {
+    if ((argc >= 4) && (std::string{argv[1]} == "--generate")) {
+        generate(argv[2], std::stoll(argv[3]),
+                 (argc == 5) ? std::stoul(argv[4]) : 0u);
+        return 0;
+    }
+    if ((argc < 2) || (argc > 3)) {
+        std::cerr << "usage: " << argv[0] << " archive [threads]\n"
+                     "       " << argv[0] << " --generate archive games [seed]"
+                  << std::endl;
+        return 1;
+    }
+    MappedFile const archive{argv[1]};
+    if (!archive) {
+        std::cerr << "cannot map: " << argv[1] << std::endl;
+        return 1;
+    }
+    unsigned threads{std::max(1u, std::thread::hardware_concurrency())};
+    if (argc == 3)
+        threads = std::max(1, std::stoi(argv[2]));
+    using std::chrono::steady_clock;
+    auto const start{steady_clock::now()};
+    auto const summary{replay_parallel(archive.begin(), archive.end(),
+                                       threads)};
+    std::chrono::duration<double> const elapsed{steady_clock::now() - start};
+    std::cout << "threads:            " << threads << '\n'
+              << "games replayed:     " << summary.games << '\n'
+              << "commands replayed:  " << summary.commands << '\n'
+              << "outcome mismatches: " << summary.mismatches << '\n';
+    if (summary.firstMismatch)
+        std::cout << "first mismatch at byte offset "
+                  << (summary.firstMismatch - archive.begin()) << '\n';
+    std::cout << "elapsed seconds:    " << elapsed.count() << '\n'
+              << "commands/second:    " << summary.commands / elapsed.count()
+              << std::endl;
+    return (summary.mismatches == 0) ? 0 : 2;
+}
+
+#endif
@@ -0,0 +1,655 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+void runChessClock(std::ostream& clkout)
+{
+    ChessClock chessClock{};
+    char command;
+    while (std::cin.get(command)) {
+        command = std::tolower(static_cast<unsigned char>(command));
+        if (is_command(command)) {
+            std::cout << "===> " << command << std::endl;
+            switch (command) {
+                case '?':
+                    std::cout << "*** Chess Clock Commands ***\n"
+                                 "r - reset player clocks to initial time\n"
+                                 "s - start the game (white draws first)\n"
+                                 "p - pause the game\n"
+                                 "c - continue the game\n"
+                                 "x - switch to the other player\n"
+                                 "0..9 - advance the active player clock\n"
+                                 "--- General Commends ---\n"
+                                 "? - show this list of commands\n"
+                                 ". - end the chess clock program\n";
+                    break;
+                case '.':
+                    std::cout << "Thanks for using the Chess-Clock" << std::endl;
+                    return;
+                default:
+                    if (!chessClock.process(command))
+                        continue;
+            }
+            chessClock.show(clkout);
+        }
+    }
+}
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>  // std::memcpy
+#include <fcntl.h>  // open
+#include <unistd.h> // read
+                    // close
+
+// The headless mode reads the commands in large blocks directly from
+// a file descriptor (bypassing `std::cin` and its per-character
+// overhead) and does not show anything for the individual commands.
+// Only the final state and some summary counters are reported.
+
+struct HeadlessSummary {
+    long long bytes{};
+    long long commands{};
+    long long ignored{};
+    long long whiteWins{};
+    long long blackWins{};
+    std::array<long long, 128> perCommand{};
+    void show(std::ostream&, std::chrono::duration<double>) const;
+};
+
+void HeadlessSummary::show(std::ostream& os,
+                           std::chrono::duration<double> elapsed) const {
+    os << "bytes read:         " << bytes << '\n'
+       << "commands processed: " << commands << '\n'
+       << "commands ignored:   " << ignored << '\n'
+       << "white player won:   " << whiteWins << '\n'
+       << "black player won:   " << blackWins << '\n'
+       << "commands by type:  ";
+    for (int c{}; c < static_cast<int>(perCommand.size()); ++c)
+        if (perCommand[c])
+            os << ' ' << static_cast<char>(c) << '=' << perCommand[c];
+    os << '\n'
+       << "elapsed seconds:    " << elapsed.count() << '\n'
+       << "commands/second:    " << commands / elapsed.count() << std::endl;
+}
+
+// For bulk input the commands are not filtered character by character
+// but by a scanner which classifies a whole block of bytes at once (16
+// with SSE2, 32 with AVX2 and BMI2), converts upper case letters to lower case,
+// and compacts the remaining command characters into an output buffer,
+// which is then handed to the FSM. The scalar version is the fallback
+// on other platforms and for the tail of a block. All versions return
+// the number of command characters stored in `out`, which must have
+// room for `n` characters.
+
+std::size_t scan_commands_scalar(const char* in, std::size_t n, char* out) {
+    auto const out_begin{out};
+    for (auto const end{in + n}; in != end; ++in) {
+        char const command = std::tolower(static_cast<unsigned char>(*in));
+        if (is_command(command))
+            *out++ = command;
+    }
+    return out - out_begin;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+// Append the bytes of a (lowered) block selected by `mask` (bit i set
+// for byte i) to `out`; the common case of a block consisting only of
+// commands is simply copied as a whole. Note that the BMI2 version
+// always stores 8 bytes, which is safe as `out` never runs ahead of
+// the input position.
+
+inline char* compact(const char* bytes, std::uint32_t mask, char* out) {
+    while (mask) {
+        *out++ = bytes[__builtin_ctz(mask)];
+        mask &= mask - 1;
+    }
+    return out;
+}
+
+__attribute__((target("bmi2")))
+inline char* compact_bmi2(const char* bytes, std::uint32_t mask, int n,
+                          char* out) {
+    for (int i{}; i < n; i += 8, mask >>= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof word);
+        auto const selected{_pdep_u64(mask & 0xFFu, 0x0101010101010101u)
+                            * 0xFFu};
+        auto const packed{_pext_u64(word, selected)};
+        std::memcpy(out, &packed, sizeof packed);
+        out += __builtin_popcount(mask & 0xFFu);
+    }
+    return out;
+}
+
+inline __m128i in_range_sse2(__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)),
+                         _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), v));
+}
+
+std::size_t scan_commands_sse2(const char* in, std::size_t n, char* out) {
+    auto const out_begin{out};
+    alignas(16) char bytes[16];
+    for (; n >= 16; in += 16, n -= 16) {
+        auto const v{_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))};
+        auto const upper{in_range_sse2(v, 'A', 'Z')};
+        auto const lowered{_mm_or_si128(v, _mm_and_si128(upper,
+                                                _mm_set1_epi8(0x20)))};
+        auto const valid{_mm_or_si128(
+            _mm_or_si128(in_range_sse2(lowered, 'a', 'z'),
+                         in_range_sse2(v, '0', '9')),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('?')),
+                         _mm_cmpeq_epi8(v, _mm_set1_epi8('.'))))};
+        auto const mask{static_cast<std::uint32_t>(_mm_movemask_epi8(valid))};
+        if (mask == 0xFFFFu) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lowered);
+            out += 16;
+        }
+        else if (mask) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(bytes), lowered);
+            out = compact(bytes, mask, out);
+        }
+    }
+    return (out - out_begin) + scan_commands_scalar(in, n, out);
+}
+
+__attribute__((target("avx2")))
+inline __m256i in_range_avx2(__m256i v, char lo, char hi) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1)),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v));
+}
+
+__attribute__((target("avx2,bmi2")))
+std::size_t scan_commands_avx2(const char* in, std::size_t n, char* out) {
+    auto const out_begin{out};
+    alignas(32) char bytes[32];
+    for (; n >= 32; in += 32, n -= 32) {
+        auto const v{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in))};
+        auto const upper{in_range_avx2(v, 'A', 'Z')};
+        auto const lowered{_mm256_or_si256(v, _mm256_and_si256(upper,
+                                                _mm256_set1_epi8(0x20)))};
+        auto const valid{_mm256_or_si256(
+            _mm256_or_si256(in_range_avx2(lowered, 'a', 'z'),
+                            in_range_avx2(v, '0', '9')),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('?')),
+                            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.'))))};
+        auto const mask{static_cast<std::uint32_t>(_mm256_movemask_epi8(valid))};
+        if (mask == 0xFFFFFFFFu) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), lowered);
+            out += 32;
+        }
+        else if (mask) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(bytes), lowered);
+            out = compact_bmi2(bytes, mask, 32, out);
+        }
+    }
+    return (out - out_begin) + scan_commands_sse2(in, n, out);
+}
+
+#endif
+
+using ScanFunction = std::size_t(*)(const char*, std::size_t, char*);
+
+ScanFunction best_scanner() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2"))
+        return scan_commands_avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return scan_commands_sse2;
+#endif
+    return scan_commands_scalar;
+}
+
+HeadlessSummary runHeadless(int fd, ChessClock& chessClock,
+                            ScanFunction scan = best_scanner())
+{
+    HeadlessSummary summary{};
+    static char buffer[1<<16];
+    static char commands[sizeof buffer];
+    for (;;) {
+        auto const n{::read(fd, buffer, sizeof buffer)};
+        if (n <= 0)
+            return summary;
+        summary.bytes += n;
+        auto const count{scan(buffer, n, commands)};
+        for (auto p{commands}; p != commands + count; ++p) {
+            char const command{*p};
+            ++summary.commands;
+            ++summary.perCommand[command];
+            if (command == '.')
+                return summary;
+            if (!chessClock.process(command)) {
+                ++summary.ignored;
+                continue;
+            }
+            switch (chessClock.state()) {
+            case GameState::WhiteWins: ++summary.whiteWins; break;
+            case GameState::BlackWins: ++summary.blackWins; break;
+            default: ;//avoid warning
+            }
+        }
+    }
+}
+
+#include <fstream>
+#include <vector>
+
+// Compares the throughput of filtering a file (without running the
+// FSM) character by character through an `std::istream` (as in
+// `runChessClock`) with the block scanners.
+
+void benchmark_scanners(const char* path) {
+    using std::chrono::steady_clock;
+    auto const report = [](const char* name, long long bytes,
+                           long long commands, steady_clock::duration d) {
+        std::chrono::duration<double> const seconds{d};
+        std::cout << std::setw(12) << name << ": "
+                  << std::setw(8) << bytes / seconds.count() / 1e9 << " GB/s"
+                  << " (" << commands << " commands)" << std::endl;
+    };
+    {
+        std::ifstream input{path, std::ios::binary};
+        long long bytes{}, commands{};
+        auto const start{steady_clock::now()};
+        char command;
+        while (input.get(command)) {
+            ++bytes;
+            command = std::tolower(static_cast<unsigned char>(command));
+            if (is_command(command))
+                ++commands;
+        }
+        report("istream.get", bytes, commands, steady_clock::now() - start);
+    }
+    struct { const char* name; ScanFunction scan; } scanners[]{
+        {"scalar", scan_commands_scalar},
+#if defined(__x86_64__) || defined(__i386__)
+        {"sse2", scan_commands_sse2},
+        {"avx2", (__builtin_cpu_supports("avx2")
+               && __builtin_cpu_supports("bmi2")) ? scan_commands_avx2
+                                                  : nullptr},
+#endif
+    };
+    std::vector<char> buffer(1<<20), commands(1<<20);
+    for (auto const& scanner : scanners) {
+        if (!scanner.scan)
+            continue;
+        int const fd{::open(path, O_RDONLY)};
+        long long bytes{}, count{};
+        auto const start{steady_clock::now()};
+        for (;;) {
+            auto const n{::read(fd, buffer.data(), buffer.size())};
+            if (n <= 0)
+                break;
+            bytes += n;
+            count += scanner.scan(buffer.data(), n, commands.data());
+        }
+        report(scanner.name, bytes, count, steady_clock::now() - start);
+        ::close(fd);
+    }
+}
+
+#if 0
+
+#include <cassert>
+#include <string>
+
+void test_scanners() {
+    std::string input{};
+    for (int c{}; c < 256; ++c)
+        input += static_cast<char>(c);
+    input += "rS5x5 .?\n\n P C 9\r\nx";
+    for (std::size_t len{}; len <= input.size(); ++len) {
+        std::vector<char> expected(len+1), actual(len+1);
+        auto const count{scan_commands_scalar(input.data(), len,
+                                              expected.data())};
+        std::string const reference{expected.data(), count};
+#if defined(__x86_64__) || defined(__i386__)
+        auto const n_sse2{scan_commands_sse2(input.data(), len, actual.data())};
+        assert(std::string(actual.data(), n_sse2) == reference);
+        if (__builtin_cpu_supports("avx2")
+         && __builtin_cpu_supports("bmi2")) {
+            auto const n_avx2{scan_commands_avx2(input.data(), len,
+                                                 actual.data())};
+            assert(std::string(actual.data(), n_avx2) == reference);
+        }
+#endif
+    }
+    char out[8];
+    assert(scan_commands_scalar("R s?.\n", 6, out) == 4);
+    assert(std::string(out, 4) == "rs?.");
+}
+
+int main() {
+    test_scanners();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <string>
+
+// Usage: Step_12f [/dev/ttyX]                  (interactive)
+//        Step_12f --headless [command-file]    (batch, default is stdin)
+//        Step_12f --scan-benchmark command-file
+
+int main(int argc, char *argv[])
+{
+    if ((argc == 3) && (std::string{argv[1]} == "--scan-benchmark")) {
+        benchmark_scanners(argv[2]);
+        return 0;
+    }
+    if ((argc >= 2) && (std::string{argv[1]} == "--headless")) {
+        int fd{0};
+        if ((argc == 3)
+         && (fd = ::open(argv[2], O_RDONLY)) == -1) {
+            std::cerr << "cannot open: " << argv[2] << std::endl;
+            return 1;
+        }
+        ChessClock chessClock{};
+        using std::chrono::steady_clock;
+        auto const start{steady_clock::now()};
+        auto const summary{runHeadless(fd, chessClock)};
+        auto const elapsed{steady_clock::now() - start};
+        std::cout << "final state:        "
+                  << to_string(chessClock.state()) << '\n';
+        chessClock.show(std::cout);
+        summary.show(std::cout, elapsed);
+        return 0;
+    }
+    std::ofstream clock_display{};
+    if ((argc == 2)
+     && std::string{argv[1]}.find("/dev/tty") == 0) {
+        clock_display.open(argv[1]);
+        if (clock_display) {
+            std::cout << "CLOCK DISPLAY: " << argv[1] << std::endl;
+            clock_display << "*** CHESS CLOCK DISPLAY ***\n";
+        }
+    }
+    runChessClock(clock_display.is_open() ? clock_display : std::cout);
+}
+
+#endif
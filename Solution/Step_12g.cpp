@@ -0,0 +1,801 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    int blackTime() const { return blackPlayerClock_.get(); }
+    int whiteTime() const { return whitePlayerClock_.get(); }
+    void restore(GameState, int blackTime, int whiteTime);
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+void ChessClock::restore(GameState state, int blackTime, int whiteTime) {
+    blackPlayerClock_.set(blackTime);
+    whitePlayerClock_.set(whiteTime);
+    theGameState_ = state;
+}
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>       // std::rename
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>      // open
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // read
+                        // write
+                        // lseek
+                        // fdatasync
+                        // fsync
+                        // ftruncate
+                        // unlink
+                        // close
+
+// Every accepted command is appended to a journal as a fixed-size
+// binary record, together with the state it resulted in; every
+// `SnapshotInterval` commands (and after each reset) the clock values
+// are recorded too. After a crash the `ChessClock` is rebuilt from the
+// latest snapshot by replaying the commands recorded after it.
+//
+// As nothing before the latest snapshot is needed for recovery, the
+// journal is rotated whenever a snapshot is written: the snapshot and
+// the records after it go to a new file, which then replaces the
+// journal (`rename` is atomic and the directory is synced after it,
+// so after a crash there is always either the old or the new file).
+// Hence the journal never grows beyond one snapshot interval and the
+// recovery time does not grow with the length of the history.
+
+struct JournalRecord {
+    enum Kind : std::uint8_t { Snapshot = 'S', Command = 'C' };
+    std::uint32_t sequence;
+    std::int32_t blackTime;     // (snapshots only)
+    std::int32_t whiteTime;     // (snapshots only)
+    Kind kind;
+    char command;               // (commands only)
+    std::uint8_t state;         // GameState after the command
+    std::uint8_t check;
+    std::uint8_t checksum() const {
+        auto const bytes{reinterpret_cast<const std::uint8_t*>(this)};
+        std::uint8_t sum{};
+        for (auto p{bytes}; p != &check; ++p)
+            sum += *p;
+        return ~sum;
+    }
+};
+static_assert(sizeof(JournalRecord) == 16, "unexpected padding");
+
+// To keep the command path fast records are only collected in memory
+// and a background thread writes them all at once and syncs them to
+// disk every `interval` (aka "group commit"), ie. a crash loses at
+// most the commands of the last interval.
+
+class Journal {
+    std::string const path_;
+    int fd_{-1};
+    std::uint32_t sequence_{};
+    int sinceSnapshot_{};
+    std::vector<JournalRecord> pending_{};
+    std::vector<JournalRecord> writing_{};
+    std::mutex mutex_{};
+    std::condition_variable wakeup_{};
+    bool stopping_{};
+    std::atomic<bool> failed_{};
+    std::thread flusher_{};
+    void append(const JournalRecord&);
+    void flush_loop(std::chrono::milliseconds);
+    bool write_synced(int fd, const JournalRecord*, std::size_t count);
+    bool rotate(const JournalRecord*, std::size_t count);
+    void sync_directory() const;
+public:
+    static constexpr int SnapshotInterval{1024};
+    Journal(const char* path, std::uint32_t nextSequence,
+            std::chrono::milliseconds interval
+                = std::chrono::milliseconds{10});
+    Journal(const Journal&)            =delete;
+    Journal& operator=(const Journal&) =delete;
+    ~Journal();
+    explicit operator bool() const { return fd_ != -1; }
+    bool failed() const { return failed_; }
+    void record(char command, const ChessClock&);
+    void snapshot(const ChessClock&);
+};
+
+Journal::Journal(const char* path, std::uint32_t nextSequence,
+                 std::chrono::milliseconds interval)
+    : path_{path},
+      fd_{::open(path, O_WRONLY | O_CREAT | O_APPEND, 0644)},
+      sequence_{nextSequence}
+{
+    pending_.reserve(1<<16);
+    writing_.reserve(1<<16);
+    if (fd_ != -1)
+        flusher_ = std::thread{[this, interval]{ flush_loop(interval); }};
+}
+
+Journal::~Journal() {
+    if (fd_ == -1)
+        return;
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+    }
+    wakeup_.notify_one();
+    flusher_.join();
+    ::close(fd_);
+}
+
+// Once a write fails the journal stops: records written later would
+// not follow the last one on disk without a gap in the sequence, so
+// recovery could not use them anyway.
+
+void Journal::flush_loop(std::chrono::milliseconds interval) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    for (;;) {
+        wakeup_.wait_for(lock, interval, [this]{ return stopping_; });
+        bool const last_round{stopping_};
+        writing_.swap(pending_);
+        lock.unlock();
+        if (!writing_.empty() && !failed_) {
+            auto snapshot{writing_.size()};
+            while ((snapshot > 0)
+                && (writing_[snapshot-1].kind != JournalRecord::Snapshot))
+                --snapshot;
+            bool const written{(snapshot > 0)
+                ? rotate(&writing_[snapshot-1],
+                         writing_.size() - (snapshot-1))
+                : write_synced(fd_, writing_.data(), writing_.size())};
+            if (!written) {
+                failed_ = true;
+                std::cerr << "journal " << path_
+                          << ": write failed, journaling stopped"
+                          << std::endl;
+            }
+        }
+        writing_.clear();
+        lock.lock();
+        if (last_round)
+            return;
+    }
+}
+
+// Appends the records and syncs them to disk. If that fails (disk full
+// or similar) the file is truncated after the last complete record, so
+// that no torn record hides the records before it from recovery.
+
+bool Journal::write_synced(int fd, const JournalRecord* records,
+                           std::size_t count) {
+    auto const start{::lseek(fd, 0, SEEK_END)};
+    auto const bytes{reinterpret_cast<const char*>(records)};
+    auto const size{count * sizeof(JournalRecord)};
+    for (std::size_t done{}; done < size; ) {
+        auto const n{::write(fd, bytes + done, size - done)};
+        if (n <= 0) {
+            if (start != -1)
+                ::ftruncate(fd, start + done / sizeof(JournalRecord)
+                                               * sizeof(JournalRecord));
+            return false;
+        }
+        done += n;
+    }
+    return ::fdatasync(fd) == 0;
+}
+
+// Replaces the journal by a new one starting with the snapshot
+// `records[0]` (if the new file can not be written the records are
+// appended to the current journal instead).
+
+bool Journal::rotate(const JournalRecord* records, std::size_t count) {
+    auto const newPath{path_ + ".new"};
+    int const fd{::open(newPath.c_str(),
+                        O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644)};
+    if (fd == -1)
+        return write_synced(fd_, records, count);
+    if (!write_synced(fd, records, count)
+     || (std::rename(newPath.c_str(), path_.c_str()) != 0)) {
+        ::close(fd);
+        ::unlink(newPath.c_str());
+        return write_synced(fd_, records, count);
+    }
+    sync_directory();
+    ::close(fd_);
+    fd_ = fd;
+    return true;
+}
+
+// The `rename` is only durable once the directory containing the
+// journal has been synced too.
+
+void Journal::sync_directory() const {
+    auto const slash{path_.rfind('/')};
+    auto const dir{(slash == std::string::npos) ? std::string{"."}
+                 : (slash == 0)                 ? std::string{"/"}
+                 : path_.substr(0, slash)};
+    int const fd{::open(dir.c_str(), O_RDONLY | O_DIRECTORY)};
+    if (fd == -1)
+        return;
+    ::fsync(fd);
+    ::close(fd);
+}
+
+void Journal::append(const JournalRecord& record) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    pending_.push_back(record);
+    pending_.back().check = record.checksum();
+}
+
+void Journal::record(char command, const ChessClock& chessClock) {
+    if (failed_)
+        return;
+    append({sequence_++, 0, 0, JournalRecord::Command, command,
+            static_cast<std::uint8_t>(chessClock.state()), 0});
+    if ((command == 'r') || (++sinceSnapshot_ >= SnapshotInterval))
+        snapshot(chessClock);
+}
+
+void Journal::snapshot(const ChessClock& chessClock) {
+    append({sequence_++, chessClock.blackTime(), chessClock.whiteTime(),
+            JournalRecord::Snapshot, 0,
+            static_cast<std::uint8_t>(chessClock.state()), 0});
+    sinceSnapshot_ = 0;
+}
+
+struct RecoveryResult {
+    std::uint32_t nextSequence{};
+    long long validRecords{};
+    long long replayedCommands{};
+    long long divergences{};    // replay did not reach recorded state
+    bool tornTail{};            // incomplete or corrupt records cut off
+};
+
+// Reads the journal (if any), truncates it after the last valid record,
+// and restores the state of `chessClock` from it.
+
+RecoveryResult recover(const char* path, ChessClock& chessClock) {
+    RecoveryResult result{};
+    int const fd{::open(path, O_RDWR)};
+    if (fd == -1)
+        return result;
+    struct stat st{};
+    ::fstat(fd, &st);
+    std::vector<JournalRecord> records(st.st_size / sizeof(JournalRecord));
+    auto const size{records.size() * sizeof(JournalRecord)};
+    if (::read(fd, records.data(), size) != static_cast<ssize_t>(size))
+        records.clear();
+    std::size_t valid{};
+    std::size_t lastSnapshot{records.size()};
+    for (; valid < records.size(); ++valid) {
+        auto const& r{records[valid]};
+        if ((r.check != r.checksum())
+         || ((valid > 0) && (r.sequence != records[valid-1].sequence + 1)))
+            break;
+        if (r.kind == JournalRecord::Snapshot)
+            lastSnapshot = valid;
+    }
+    result.tornTail = (valid * sizeof(JournalRecord)
+                            != static_cast<std::size_t>(st.st_size));
+    if (result.tornTail)
+        ::ftruncate(fd, valid * sizeof(JournalRecord));
+    ::close(fd);
+    result.validRecords = valid;
+    if (valid > 0)
+        result.nextSequence = records[valid-1].sequence + 1;
+    if (lastSnapshot >= valid)
+        return result; // (nothing to restore from)
+    auto const& s{records[lastSnapshot]};
+    chessClock.restore(static_cast<GameState>(s.state),
+                       s.blackTime, s.whiteTime);
+    for (auto i{lastSnapshot + 1}; i < valid; ++i) {
+        auto const& r{records[i]};
+        if (r.kind != JournalRecord::Command)
+            continue;
+        chessClock.process(r.command);
+        ++result.replayedCommands;
+        if (static_cast<std::uint8_t>(chessClock.state()) != r.state)
+            ++result.divergences;
+    }
+    return result;
+}
+
+void runChessClock(std::ostream& clkout, ChessClock& chessClock,
+                   Journal* journal)
+{
+    chessClock.show(clkout);
+    char command;
+    while (std::cin.get(command)) {
+        command = std::tolower(static_cast<unsigned char>(command));
+        if (is_command(command)) {
+            std::cout << "===> " << command << std::endl;
+            switch (command) {
+                case '?':
+                    std::cout << "*** Chess Clock Commands ***\n"
+                                 "r - reset player clocks to initial time\n"
+                                 "s - start the game (white draws first)\n"
+                                 "p - pause the game\n"
+                                 "c - continue the game\n"
+                                 "x - switch to the other player\n"
+                                 "0..9 - advance the active player clock\n"
+                                 "--- General Commends ---\n"
+                                 "? - show this list of commands\n"
+                                 ". - end the chess clock program\n";
+                    break;
+                case '.':
+                    std::cout << "Thanks for using the Chess-Clock" << std::endl;
+                    return;
+                default:
+                    if (!chessClock.process(command))
+                        continue;
+                    if (journal)
+                        journal->record(command, chessClock);
+            }
+            chessClock.show(clkout);
+        }
+    }
+}
+
+// Runs all commands read from `fd` without output and returns the
+// number of commands processed (used to measure the journal overhead).
+
+long long runHeadless(int fd, ChessClock& chessClock, Journal* journal)
+{
+    long long commands{};
+    static char buffer[1<<16];
+    for (;;) {
+        auto const n{::read(fd, buffer, sizeof buffer)};
+        if (n <= 0)
+            return commands;
+        for (auto p{buffer}; p != buffer + n; ++p) {
+            char const command = std::tolower(static_cast<unsigned char>(*p));
+            if (!is_command(command))
+                continue;
+            ++commands;
+            if (command == '.')
+                return commands;
+            if (chessClock.process(command) && journal)
+                journal->record(command, chessClock);
+        }
+    }
+}
+
+#if 0
+
+#include <cassert>
+#include <csignal>  // std::signal
+#include <cstdio>   // std::remove
+
+#include <sys/resource.h>   // setrlimit
+
+void test_recovery() {
+    char const path[]{"/tmp/Step_12g_test.journal"};
+    std::remove(path);
+    ChessClock original{};
+    {
+        Journal journal{path, 0};
+        for (char command : std::string{"rs5x5x6p3c4x"}
+                          + std::string(3000, 'x') + "1x2") {
+            if (original.process(command))
+                journal.record(command, original);
+        }
+    }
+    // simulate a crash in the middle of writing a record
+    {
+        int const fd{::open(path, O_WRONLY | O_APPEND)};
+        assert(::write(fd, "garbage", 7) == 7);
+        ::close(fd);
+    }
+    ChessClock recovered{};
+    auto const result{recover(path, recovered)};
+    assert(result.tornTail);
+    assert(result.divergences == 0);
+    assert(result.replayedCommands < Journal::SnapshotInterval);
+    // (the journal was rotated at the snapshots)
+    assert(result.validRecords <= Journal::SnapshotInterval + 1);
+    assert(recovered.state() == original.state());
+    assert(recovered.blackTime() == original.blackTime());
+    assert(recovered.whiteTime() == original.whiteTime());
+    // appending continues seamlessly after recovery
+    {
+        Journal journal{path, result.nextSequence};
+        if (recovered.process('x'))
+            journal.record('x', recovered);
+    }
+    original.process('x');
+    ChessClock again{};
+    auto const second{recover(path, again)};
+    assert(!second.tornTail);
+    assert(second.nextSequence == result.nextSequence + 1);
+    assert(again.state() == original.state());
+    assert(again.blackTime() == original.blackTime());
+    assert(again.whiteTime() == original.whiteTime());
+    std::remove(path);
+}
+
+// A file size limit makes the journal fail in the middle of a record
+// (like a full disk would): the complete records before it must remain
+// recoverable, and nothing is written after the failure.
+
+void test_write_failure() {
+    char const path[]{"/tmp/Step_12g_test.journal"};
+    std::remove(path);
+    auto const oldHandler{std::signal(SIGXFSZ, SIG_IGN)};
+    rlimit saved{};
+    ::getrlimit(RLIMIT_FSIZE, &saved);
+    rlimit limited{saved};
+    limited.rlim_cur = 100*sizeof(JournalRecord) + 7;
+    ::setrlimit(RLIMIT_FSIZE, &limited);
+    ChessClock chessClock{};
+    {
+        Journal journal{path, 0};
+        for (int i{}; i < 500; ++i)
+            journal.record('x', chessClock);
+        while (!journal.failed())
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        journal.record('x', chessClock);
+    }
+    ::setrlimit(RLIMIT_FSIZE, &saved);
+    std::signal(SIGXFSZ, oldHandler);
+    ChessClock recovered{};
+    auto const result{recover(path, recovered)};
+    assert(!result.tornTail);
+    assert(result.validRecords == 100);
+    assert(result.nextSequence == 100);
+    std::remove(path);
+}
+
+int main() {
+    test_recovery();
+    test_write_failure();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <fstream>
+#include <memory>       // std::unique_ptr
+#include <string>
+
+// Usage: Step_12g [--journal file] [/dev/ttyX]
+//        Step_12g [--journal file] --headless [command-file]
+
+int main(int argc, char *argv[])
+{
+    const char* journalPath{};
+    if ((argc >= 3) && (std::string{argv[1]} == "--journal")) {
+        journalPath = argv[2];
+        argv += 2;
+        argc -= 2;
+    }
+    ChessClock chessClock{};
+    std::uint32_t nextSequence{};
+    if (journalPath) {
+        auto const result{recover(journalPath, chessClock)};
+        nextSequence = result.nextSequence;
+        if (result.validRecords > 0)
+            std::cout << "RECOVERED: " << result.validRecords << " records, "
+                      << result.replayedCommands << " commands replayed"
+                      << (result.tornTail ? ", torn tail cut off" : "")
+                      << (result.divergences ? ", DIVERGED" : "")
+                      << std::endl;
+    }
+    std::unique_ptr<Journal> journal{};
+    if (journalPath) {
+        journal = std::make_unique<Journal>(journalPath, nextSequence);
+        if (!*journal) {
+            std::cerr << "cannot open journal: " << journalPath << std::endl;
+            return 1;
+        }
+        journal->snapshot(chessClock);
+    }
+    if ((argc >= 2) && (std::string{argv[1]} == "--headless")) {
+        int fd{0};
+        if ((argc == 3)
+         && (fd = ::open(argv[2], O_RDONLY)) == -1) {
+            std::cerr << "cannot open: " << argv[2] << std::endl;
+            return 1;
+        }
+        using std::chrono::steady_clock;
+        auto const start{steady_clock::now()};
+        auto const commands{runHeadless(fd, chessClock, journal.get())};
+        std::chrono::duration<double, std::nano> const elapsed{
+            steady_clock::now() - start
+        };
+        chessClock.show(std::cout);
+        std::cout << "commands: " << commands;
+        if (commands > 0)
+            std::cout << ", ns/command: " << elapsed.count() / commands;
+        std::cout << std::endl;
+        return 0;
+    }
+    std::ofstream clock_display{};
+    if ((argc == 2)
+     && std::string{argv[1]}.find("/dev/tty") == 0) {
+        clock_display.open(argv[1]);
+        if (clock_display) {
+            std::cout << "CLOCK DISPLAY: " << argv[1] << std::endl;
+            clock_display << "*** CHESS CLOCK DISPLAY ***\n";
+        }
+    }
+    runChessClock(clock_display.is_open() ? clock_display : std::cout,
+                  chessClock, journal.get());
+}
+
+#endif
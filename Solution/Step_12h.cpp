@@ -0,0 +1,568 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    int blackTime() const { return blackPlayerClock_.get(); }
+    int whiteTime() const { return whitePlayerClock_.get(); }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+#include <atomic>
+#include <cstdint>
+
+// The complete state of a board, ie. the remaining times of both
+// players (in 1/10-th seconds, less than 1000 minutes, which would
+// fit into 20 bits, stored in 28 bits each) and the `GameState` (3
+// bits), is packed into a single 64-bit word:
+//
+//     63     59 58   56 55          28 27           0
+//     +--------+-------+--------------+--------------+
+//     | unused | state |  black time  |  white time  |
+//     +--------+-------+--------------+--------------+
+//
+// A transition computes the new word from the old one, which makes it
+// possible to update a board lock-free with a single compare-and-swap
+// from any number of threads (eg. the clockwork ticking the active
+// player's clock and several sources of commands).
+
+class PackedBoard {
+    std::uint64_t word_{};
+    static constexpr int TimeBits{28};
+    static constexpr std::uint64_t TimeMask{(1u << TimeBits) - 1};
+public:
+    constexpr PackedBoard() =default;
+    constexpr explicit PackedBoard(std::uint64_t word) : word_{word} {}
+    constexpr PackedBoard(GameState state, int blackTime, int whiteTime)
+        : word_{(static_cast<std::uint64_t>(state) << 2*TimeBits)
+              | (static_cast<std::uint64_t>(blackTime) << TimeBits)
+              | static_cast<std::uint64_t>(whiteTime)}
+    {/*empty*/}
+    constexpr std::uint64_t word() const { return word_; }
+    constexpr GameState state() const {
+        return static_cast<GameState>(word_ >> 2*TimeBits);
+    }
+    constexpr int blackTime() const {
+        return static_cast<int>((word_ >> TimeBits) & TimeMask);
+    }
+    constexpr int whiteTime() const {
+        return static_cast<int>(word_ & TimeMask);
+    }
+    // sets `next` to the board after `command`, returns `false` (and
+    // leaves `next` unchanged) if the command is ignored in this state
+    bool after(char command, PackedBoard& next) const;
+};
+
+bool PackedBoard::after(char command, PackedBoard& next) const {
+    auto const state_{state()};
+    auto const black_{blackTime()};
+    auto const white_{whiteTime()};
+    int ticksToSimulate{};
+    switch (command) {
+        case 'r':
+            if (not (state_ == GameState::Initial
+                  || state_ == GameState::BlackWins
+                  || state_ == GameState::WhiteWins
+                  || state_ == GameState::BlackPaused
+                  || state_ == GameState::WhitePaused))
+                  return false;
+            next = {GameState::Startable, InitialTime, InitialTime};
+            return true;
+        case 's': // start clock (white draws first)
+            if (not (state_ == GameState::Startable))
+                return false;
+            next = {GameState::WhiteDraw, black_, white_};
+            return true;
+        case 'p':
+            switch (state_) {
+            case GameState::BlackDraw:
+                next = {GameState::BlackPaused, black_, white_};
+                return true;
+            case GameState::WhiteDraw:
+                next = {GameState::WhitePaused, black_, white_};
+                return true;
+            default:
+                return false;
+            }
+        case 'c': // coninue game
+            switch (state_) {
+            case GameState::BlackPaused:
+                next = {GameState::BlackDraw, black_, white_};
+                return true;
+            case GameState::WhitePaused:
+                next = {GameState::WhiteDraw, black_, white_};
+                return true;
+            default:
+                return false;
+            }
+        case 'x':
+            switch (state_) {
+            case GameState::BlackDraw:
+                next = {GameState::WhiteDraw, black_, white_};
+                return true;
+            case GameState::WhiteDraw:
+                next = {GameState::BlackDraw, black_, white_};
+                return true;
+            default:
+                return false;
+            }
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (state_) {
+            case GameState::BlackDraw:
+                if (black_ > ticksToSimulate)
+                    next = {state_, black_ - ticksToSimulate, white_};
+                else
+                    next = {GameState::WhiteWins, 0, white_};
+                return true;
+            case GameState::WhiteDraw:
+                if (white_ > ticksToSimulate)
+                    next = {state_, black_, white_ - ticksToSimulate};
+                else
+                    next = {GameState::BlackWins, black_, 0};
+                return true;
+            default:
+                return false;
+            }
+        default:
+            return false;
+    }
+}
+
+class AtomicBoard {
+    std::atomic<std::uint64_t> word_{};
+public:
+    PackedBoard load() const {
+        return PackedBoard{word_.load(std::memory_order_acquire)};
+    }
+    // applies `command` atomically, returns `false` if it was ignored
+    bool apply(char command) {
+        auto expected{word_.load(std::memory_order_relaxed)};
+        for (;;) {
+            PackedBoard next{};
+            if (!PackedBoard{expected}.after(command, next))
+                return false;
+            if (next.word() == expected)
+                return true; // (eg. advancing by zero ticks)
+            if (word_.compare_exchange_weak(expected, next.word(),
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_relaxed))
+                return true;
+        }
+    }
+    bool tick() { return apply('1'); }
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "packed board needs lock-free 64-bit atomics");
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Contention benchmark: one thread ticks the board as fast as it can
+// while the others fire commands at it. For comparison the same is
+// done with a `ChessClock` protected by a mutex. The game is started
+// before and restarted by the ticking thread whenever a tick is not
+// accepted (the game was won or paused), so that ticks really change
+// the board even if there are no other threads.
+
+template<typename Board>
+double hammer(Board& board, int threads, long opsPerThread) {
+    std::atomic<bool> go{};
+    board.apply('r');
+    board.apply('s');
+    std::vector<std::thread> workers{};
+    for (int t{}; t < threads; ++t)
+        workers.emplace_back([&board, &go, t, opsPerThread]{
+            static const char commands[]{"rscpxx"};
+            while (!go) {/*spin*/}
+            for (long i{}; i < opsPerThread; ++i) {
+                if (t != 0)
+                    board.apply(commands[i % 6]);
+                else if (!board.apply('1')) {
+                    board.apply('r');
+                    board.apply('s');
+                }
+            }
+        });
+    using std::chrono::steady_clock;
+    auto const start{steady_clock::now()};
+    go = true;
+    for (auto& w : workers)
+        w.join();
+    std::chrono::duration<double> const elapsed{steady_clock::now() - start};
+    return threads * opsPerThread / elapsed.count();
+}
+
+class LockedChessClock {
+    std::mutex mutex_{};
+    ChessClock chessClock_{};
+public:
+    bool apply(char command) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return chessClock_.process(command);
+    }
+};
+
+void benchmark_contention(int maxThreads, long opsPerThread) {
+    std::cout << "threads   CAS ops/s   mutex ops/s" << std::endl;
+    for (int threads{1}; threads <= maxThreads; threads *= 2) {
+        AtomicBoard lockFree{};
+        LockedChessClock locked{};
+        auto const casRate{hammer(lockFree, threads, opsPerThread)};
+        auto const mutexRate{hammer(locked, threads, opsPerThread)};
+        std::cout << std::setw(7) << threads
+                  << std::setw(12) << casRate
+                  << std::setw(14) << mutexRate << std::endl;
+    }
+}
+
+#if 0
+
+#include <cassert>
+#include <random>
+
+void test_packing() {
+    constexpr PackedBoard b{GameState::BlackPaused, 599'999, 12'345};
+    static_assert(b.state() == GameState::BlackPaused, "");
+    static_assert(b.blackTime() == 599'999, "");
+    static_assert(b.whiteTime() == 12'345, "");
+    static_assert(PackedBoard{}.state() == GameState::Initial, "");
+}
+
+void test_same_as_chess_clock() {
+    std::mt19937 rng{42};
+    static const char alphabet[]{"rspcx0123456789"};
+    std::uniform_int_distribution<int> pick{0, sizeof alphabet - 2};
+    ChessClock reference{};
+    AtomicBoard board{};
+    for (int i{}; i < 1'000'000; ++i) {
+        char const command{alphabet[pick(rng)]};
+        assert(board.apply(command) == reference.process(command));
+        auto const b{board.load()};
+        assert(b.state() == reference.state());
+        assert(b.blackTime() == reference.blackTime());
+        assert(b.whiteTime() == reference.whiteTime());
+    }
+}
+
+void test_concurrent_ticks() {
+    AtomicBoard board{};
+    board.apply('r');
+    board.apply('s');
+    std::vector<std::thread> tickers{};
+    for (int t{}; t < 4; ++t)
+        tickers.emplace_back([&board]{
+            for (int i{}; i < 1000; ++i)
+                board.tick();
+        });
+    for (auto& t : tickers)
+        t.join();
+    assert(board.load().whiteTime() == InitialTime - 4000);
+    assert(board.load().blackTime() == InitialTime);
+}
+
+int main() {
+    test_packing();
+    test_same_as_chess_clock();
+    test_concurrent_ticks();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <algorithm>    // std::max
+#include <string>
+
+// Usage: Step_12h [max-threads [operations-per-thread]]
+
+int main(int argc, char* argv[]) {
+    int maxThreads{static_cast<int>(std::thread::hardware_concurrency())};
+    long opsPerThread{1'000'000};
+    if (argc >= 2)
+        maxThreads = std::stoi(argv[1]);
+    if (argc >= 3)
+        opsPerThread = std::stol(argv[2]);
+    benchmark_contention(std::max(maxThreads, 1), opsPerThread);
+}
+
+#endif
@@ -0,0 +1,348 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <atomic>   // std::atomic
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+// The clockwork thread steps the player clocks while the main thread
+// shows them, so (without further precautions) the display may show a
+// value in the middle of a borrow, eg. 10:00.9 when stepping from
+// 10:00.0 to 9:59.9. Therefore the (single) writer now publishes the
+// counter values after each modification with a sequence lock, from
+// which any number of readers can take a consistent snapshot: the
+// sequence number is odd while the values are updated and a reader
+// retries until it sees the same even number before and after reading
+// the values. Readers never block the writer and the writer only pays
+// for a few (uncontended) stores. (Instead of stand-alone fences the
+// values themselves are stored with release and loaded with acquire
+// semantics, which costs nothing extra on x86 and is understood by
+// ThreadSanitizer.)
+
+class Clock {
+public:
+    struct Snapshot {
+        int minutes;
+        int seconds;
+        int tenthsecs;
+        int total() const { return (minutes*60 + seconds)*10 + tenthsecs; }
+    };
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+    // published values (written by the writer thread only)
+    std::atomic<unsigned> sequence_{};
+    std::atomic<int> publishedMinutes_{};
+    std::atomic<int> publishedSeconds_{};
+    std::atomic<int> publishedTenthsecs_{};
+    void publish();
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    // writer side (may only be called from one thread at a time)
+    void set(int);
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    // reader side (may be called from any thread)
+    Snapshot snapshot() const;
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::publish() {
+    auto const seq{sequence_.load(std::memory_order_relaxed)};
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    // (release: a reader seeing any new value also sees the odd number)
+    publishedMinutes_.store(minutes_.get(), std::memory_order_release);
+    publishedSeconds_.store(seconds_.get(), std::memory_order_release);
+    publishedTenthsecs_.store(tenthsecs_.get(), std::memory_order_release);
+    sequence_.store(seq + 2, std::memory_order_release);
+}
+
+Clock::Snapshot Clock::snapshot() const {
+    Snapshot result;
+    unsigned before, after;
+    do {
+        before = sequence_.load(std::memory_order_acquire);
+        result.minutes = publishedMinutes_.load(std::memory_order_acquire);
+        result.seconds = publishedSeconds_.load(std::memory_order_acquire);
+        result.tenthsecs = publishedTenthsecs_.load(std::memory_order_acquire);
+        after = sequence_.load(std::memory_order_relaxed);
+    } while ((before & 1) || (before != after));
+    return result;
+}
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+    publish();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    publish();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const value{snapshot()};
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << value.minutes << ':'
+       << setfill('0') << setw(2) << value.seconds << '.'
+                       << setw(1) << value.tenthsecs;
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// (publishes only once after all steps are done)
+bool Clock::operator-=(int steps) {
+    bool counting{true};
+    while (steps > 0) {
+        if (!tenthsecs_.is_counting()) {
+            counting = false;
+            break;
+        }
+        tenthsecs_.step();
+        --steps;
+    }
+    publish();
+    return counting;
+}
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// One writer counts a clock down from its maximum value tick by tick
+// while `readers` threads keep taking snapshots. Every snapshot has to
+// be a valid clock value not larger than the one read before (as the
+// clock only counts down), a torn read like 10:00.9 would violate this.
+// Returns the number of writes and (total) reads per second, the
+// number of inconsistent snapshots seen, and how many snapshots were
+// taken while the clock was running (ie. neither the value before
+// nor after it ran down). To make sure readers and writer really
+// overlap (eg. on a single core) the writer yields every now and then
+// until the readers have taken `MinOverlapped` of these snapshots.
+
+constexpr long long MinOverlapped{1000};
+
+struct StressResult {
+    double writesPerSecond;
+    double readsPerSecond;
+    long long reads;
+    long long overlapped;
+    long long violations;
+};
+
+StressResult stress(int readers) {
+    constexpr int ticks{1000*60*10 - 1}; // 999:59.9
+    Clock clk{};
+    clk.set(ticks);
+    std::atomic<bool> done{};
+    std::atomic<long long> reads{}, violations{}, overlapped{};
+    std::vector<std::thread> threads{};
+    for (int r{}; r < readers; ++r)
+        threads.emplace_back([&]{
+            long long myReads{}, myViolations{}, myOverlapped{};
+            auto previous{clk.snapshot().total()};
+            while (!done.load(std::memory_order_relaxed)) {
+                auto const s{clk.snapshot()};
+                ++myReads;
+                if ((s.seconds < 0) || (s.seconds >= 60)
+                 || (s.tenthsecs < 0) || (s.tenthsecs >= 10)
+                 || (s.total() > previous))
+                    ++myViolations;
+                if ((0 < s.total()) && (s.total() < ticks)
+                 && (++myOverlapped <= MinOverlapped))
+                    overlapped.fetch_add(1, std::memory_order_relaxed);
+                previous = s.total();
+            }
+            reads += myReads;
+            violations += myViolations;
+        });
+    using std::chrono::steady_clock;
+    auto const start{steady_clock::now()};
+    for (int n{}; clk; ++n) {
+        --clk;
+        if ((readers > 0) && (n % 1024 == 0)
+         && (overlapped.load(std::memory_order_relaxed) < MinOverlapped))
+            std::this_thread::yield();
+    }
+    std::chrono::duration<double> const elapsed{steady_clock::now() - start};
+    done = true;
+    for (auto& t : threads)
+        t.join();
+    return {ticks / elapsed.count(),
+            reads / elapsed.count(),
+            reads.load(),
+            overlapped.load(),
+            violations.load()};
+}
+
+#if 1
+
+#include <cassert>
+#include <sstream>
+
+void test_snapshot() {
+    Clock clk{};
+    clk.set(6000);
+    --clk;
+    auto const s{clk.snapshot()};
+    assert(s.minutes == 9); assert(s.seconds == 59); assert(s.tenthsecs == 9);
+    clk -= 5999;
+    assert(clk.snapshot().total() == 0);
+    std::ostringstream oss{};
+    oss << clk;
+    assert(oss.str() == "  0:00.0");
+}
+
+// Run this also with ThreadSanitizer, eg.
+//      g++ -std=c++17 -O1 -g -fsanitize=thread Step_12i.cpp
+
+int main() {
+    test_snapshot();
+    for (int readers{0}; readers <= 4; readers += (readers ? readers : 1)) {
+        auto const result{stress(readers)};
+        assert(result.violations == 0);
+        if (readers > 0) {
+            assert(result.reads > 0);
+            assert(result.overlapped >= MinOverlapped);
+        }
+        std::cout << readers << " readers: "
+                  << result.writesPerSecond << " writes/s, "
+                  << result.readsPerSecond << " reads/s" << std::endl;
+    }
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <functional>
+
+// The clockwork of Step 12 runs the clock while the main thread shows
+// it on every return; with the snapshot the displayed values are
+// always consistent.
+
+class ClockWork {
+    std::atomic<bool> stopping_{};
+    std::function<void()> subscriber_{};
+    std::thread cw_thread_{};
+public:
+    auto start() {
+        cw_thread_ = std::thread{[this]{
+                while (!stopping_) {
+                    if (subscriber_)
+                        subscriber_();
+                    using namespace std::chrono_literals;
+                    std::this_thread::sleep_for(100ms);
+                }
+            }
+        };
+    }
+    auto stop() {
+        stopping_ = true;
+        if (cw_thread_.joinable())
+            cw_thread_.join();
+        stopping_ = false;
+    }
+    void attach(std::function<void()> subscriber) {
+        subscriber_ = subscriber;
+    }
+};
+
+int main() {
+    Clock clk{};
+    clk.set(InitialTime);
+    ClockWork cw{};
+    cw.attach([&clk]{ --clk; });
+    cw.start();
+    std::cout << "... hit return to show clock, '.' to end" << std::endl;
+    char c;
+    while (std::cin.get(c) && (c != '.'))
+        if (c == '\n')
+            std::cout << clk << std::endl;
+    cw.stop();
+}
+
+#endif
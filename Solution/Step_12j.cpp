@@ -0,0 +1,339 @@
+#include <cstdint>  // std::uint64_t
+#include <iomanip>  // std::setw
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+
+constexpr int InitialTime{30*60*10};
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+// The state of a board packed into 64 bits as in Step 12h (see there
+// for the layout).
+
+class PackedBoard {
+    std::uint64_t word_{};
+    static constexpr int TimeBits{28};
+    static constexpr std::uint64_t TimeMask{(1u << TimeBits) - 1};
+public:
+    constexpr PackedBoard() =default;
+    constexpr explicit PackedBoard(std::uint64_t word) : word_{word} {}
+    constexpr PackedBoard(GameState state, int blackTime, int whiteTime)
+        : word_{(static_cast<std::uint64_t>(state) << 2*TimeBits)
+              | (static_cast<std::uint64_t>(blackTime) << TimeBits)
+              | static_cast<std::uint64_t>(whiteTime)}
+    {/*empty*/}
+    constexpr std::uint64_t word() const { return word_; }
+    constexpr GameState state() const {
+        return static_cast<GameState>(word_ >> 2*TimeBits);
+    }
+    constexpr int blackTime() const {
+        return static_cast<int>((word_ >> TimeBits) & TimeMask);
+    }
+    constexpr int whiteTime() const {
+        return static_cast<int>(word_ & TimeMask);
+    }
+    // sets `next` to the board after `command`, returns `false` (and
+    // leaves `next` unchanged) if the command is ignored in this state
+    // (`initialTime` is the time both clocks are reset to with 'r')
+    bool after(char command, PackedBoard& next,
+               int initialTime = InitialTime) const;
+};
+
+bool PackedBoard::after(char command, PackedBoard& next,
+                        int initialTime) const {
+    auto const state_{state()};
+    auto const black_{blackTime()};
+    auto const white_{whiteTime()};
+    int ticksToSimulate{};
+    switch (command) {
+        case 'r':
+            if (not (state_ == GameState::Initial
+                  || state_ == GameState::BlackWins
+                  || state_ == GameState::WhiteWins
+                  || state_ == GameState::BlackPaused
+                  || state_ == GameState::WhitePaused))
+                  return false;
+            next = {GameState::Startable, initialTime, initialTime};
+            return true;
+        case 's': // start clock (white draws first)
+            if (not (state_ == GameState::Startable))
+                return false;
+            next = {GameState::WhiteDraw, black_, white_};
+            return true;
+        case 'p':
+            switch (state_) {
+            case GameState::BlackDraw:
+                next = {GameState::BlackPaused, black_, white_};
+                return true;
+            case GameState::WhiteDraw:
+                next = {GameState::WhitePaused, black_, white_};
+                return true;
+            default:
+                return false;
+            }
+        case 'c': // coninue game
+            switch (state_) {
+            case GameState::BlackPaused:
+                next = {GameState::BlackDraw, black_, white_};
+                return true;
+            case GameState::WhitePaused:
+                next = {GameState::WhiteDraw, black_, white_};
+                return true;
+            default:
+                return false;
+            }
+        case 'x':
+            switch (state_) {
+            case GameState::BlackDraw:
+                next = {GameState::WhiteDraw, black_, white_};
+                return true;
+            case GameState::WhiteDraw:
+                next = {GameState::BlackDraw, black_, white_};
+                return true;
+            default:
+                return false;
+            }
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (state_) {
+            case GameState::BlackDraw:
+                if (black_ > ticksToSimulate)
+                    next = {state_, black_ - ticksToSimulate, white_};
+                else
+                    next = {GameState::WhiteWins, 0, white_};
+                return true;
+            case GameState::WhiteDraw:
+                if (white_ > ticksToSimulate)
+                    next = {state_, black_, white_ - ticksToSimulate};
+                else
+                    next = {GameState::BlackWins, black_, 0};
+                return true;
+            default:
+                return false;
+            }
+        default:
+            return false;
+    }
+}
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <utility>  // std::move
+#include <vector>
+
+// With many boards in one process and each board ticked by the thread
+// owning it, boards which are owned by different threads but happen
+// to share a cache line make the line bounce between the cores (aka
+// "false sharing"), even though no data is shared at all. Therefore
+// the data of a board is split into
+// - the hot part, modified with every tick, which is aligned to (and
+//   hence occupies) a cache line of its own, and
+// - the cold part, ie. configuration rarely read and never modified
+//   while the game runs, kept in a separate (densely packed) array.
+// (`std::hardware_destructive_interference_size` would be the portable
+// choice for the alignment, but compilers warn that its value may
+// differ between compilation units, hence a constant is used.)
+
+constexpr std::size_t CacheLineSize{64};
+
+struct alignas(CacheLineSize) BoardHotState {
+    PackedBoard board{};
+    long long ticks{};          // ticks delivered to this board
+};
+static_assert(alignof(BoardHotState) == CacheLineSize, "");
+static_assert(sizeof(BoardHotState) == CacheLineSize, "");
+
+struct BoardConfig {
+    int initialTime{InitialTime};
+    std::string whitePlayer{};
+    std::string blackPlayer{};
+};
+
+// Advances the board by one tick, restarting the game with the
+// initial time of its configuration when it ended (so that there is
+// always something to tick); only the restart reads the configuration.
+
+inline void tick(PackedBoard& board, long long& ticks,
+                 const BoardConfig& config) {
+    PackedBoard next{};
+    if (!board.after('1', next)) {
+        board.after('r', next, config.initialTime);
+        next.after('s', next);
+    }
+    board = next;
+    ++ticks;
+}
+
+class Boards {
+    std::vector<BoardHotState> hot_;
+    std::vector<BoardConfig> cold_;
+public:
+    explicit Boards(std::size_t count) : hot_(count), cold_(count) {}
+    std::size_t size() const { return hot_.size(); }
+    BoardHotState& hot(std::size_t i) { return hot_[i]; }
+    const BoardConfig& config(std::size_t i) const { return cold_[i]; }
+    void configure(std::size_t i, BoardConfig config) {
+        cold_[i] = std::move(config);
+    }
+    void tick(std::size_t i) {
+        ::tick(hot_[i].board, hot_[i].ticks, cold_[i]);
+    }
+};
+
+// For comparison: all data of a board in one densely packed object.
+
+struct CompactBoard {
+    PackedBoard board{};
+    long long ticks{};
+    BoardConfig config{};
+};
+
+// Each of `threads` threads owns every `threads`-th board (ie. boards
+// owned by different threads are next to each other) and ticks them
+// round by round; returns the ticks per second of all threads.
+
+template<typename TickBoard>
+double tick_throughput(int threads, std::size_t boards, long rounds,
+                       TickBoard tickBoard) {
+    std::atomic<int> ready{};
+    std::vector<std::thread> workers{};
+    using std::chrono::steady_clock;
+    steady_clock::time_point start{};
+    for (int t{}; t < threads; ++t)
+        workers.emplace_back([&, t]{
+            if (++ready == threads)
+                start = steady_clock::now();
+            while (ready < threads) {/*spin*/}
+            for (long r{}; r < rounds; ++r)
+                for (auto b{static_cast<std::size_t>(t)}; b < boards;
+                                                         b += threads)
+                    tickBoard(b);
+        });
+    for (auto& w : workers)
+        w.join();
+    std::chrono::duration<double> const elapsed{steady_clock::now() - start};
+    return ((boards / threads) * threads) * rounds / elapsed.count();
+}
+
+void benchmark_scaling(int maxThreads, std::size_t boardsPerThread,
+                       long rounds) {
+    std::cout << "threads  compact ticks/s   isolated ticks/s" << std::endl;
+    for (int threads{1}; threads <= maxThreads; ++threads) {
+        auto const count{boardsPerThread * threads};
+        std::vector<CompactBoard> compact(count);
+        Boards isolated{count};
+        auto const compactRate{tick_throughput(threads, count, rounds,
+            [&compact](std::size_t b) {
+                tick(compact[b].board, compact[b].ticks, compact[b].config);
+            })};
+        auto const isolatedRate{tick_throughput(threads, count, rounds,
+            [&isolated](std::size_t b) {
+                isolated.tick(b);
+            })};
+        std::cout << std::setw(7) << threads
+                  << std::setw(17) << compactRate
+                  << std::setw(19) << isolatedRate << std::endl;
+    }
+}
+
+#if 0
+
+#include <cassert>
+#include <cstdint>  // std::uintptr_t
+
+std::uintptr_t cache_line(const void* p) {
+    return reinterpret_cast<std::uintptr_t>(p) / CacheLineSize;
+}
+
+void test_hot_state_layout() {
+    assert(alignof(BoardHotState) == CacheLineSize);
+    assert(sizeof(BoardHotState) == CacheLineSize);
+    Boards boards{3};
+    for (std::size_t i{}; i < boards.size(); ++i)
+        assert(reinterpret_cast<std::uintptr_t>(&boards.hot(i))
+                    % CacheLineSize == 0);
+    // the first and last byte of a board's hot state are on one line,
+    // adjacent boards on different ones
+    auto const first{reinterpret_cast<const char*>(&boards.hot(0))};
+    assert(cache_line(first) == cache_line(first + CacheLineSize - 1));
+    assert(cache_line(&boards.hot(0)) != cache_line(&boards.hot(1)));
+    assert(cache_line(&boards.hot(1)) != cache_line(&boards.hot(2)));
+}
+
+void test_reset_uses_config() {
+    Boards boards{2};
+    boards.configure(0, {600, "Carlsen", "Nepomniachtchi"});
+    assert(boards.config(0).initialTime == 600);
+    assert(boards.config(1).initialTime == InitialTime);
+    boards.tick(0); // (restarts the game from `Initial`)
+    boards.tick(1);
+    auto const& board{boards.hot(0).board};
+    assert(board.state() == GameState::WhiteDraw);
+    assert(board.whiteTime() == 600); assert(board.blackTime() == 600);
+    assert(boards.hot(1).board.whiteTime() == InitialTime);
+    for (int i{}; i < 600; ++i)
+        boards.tick(0);
+    assert(board.state() == GameState::BlackWins);
+    assert(board.whiteTime() == 0);
+    boards.tick(0);
+    assert(board.state() == GameState::WhiteDraw);
+    assert(board.whiteTime() == 600);
+    assert(boards.hot(0).ticks == 602);
+    assert(boards.hot(1).ticks == 1);
+}
+
+void test_same_ticks_compact_and_isolated() {
+    CompactBoard compact{};
+    compact.config.initialTime = 50;
+    Boards isolated{1};
+    isolated.configure(0, compact.config);
+    for (int i{}; i < 1000; ++i) {
+        tick(compact.board, compact.ticks, compact.config);
+        isolated.tick(0);
+        assert(compact.board.word() == isolated.hot(0).board.word());
+    }
+}
+
+int main() {
+    test_hot_state_layout();
+    test_reset_uses_config();
+    test_same_ticks_compact_and_isolated();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+// Usage: Step_12j [max-threads [boards-per-thread [rounds]]]
+
+int main(int argc, char* argv[]) {
+    int maxThreads{static_cast<int>(std::thread::hardware_concurrency())};
+    std::size_t boardsPerThread{64};
+    long rounds{200'000};
+    if (argc >= 2)
+        maxThreads = std::stoi(argv[1]);
+    if (argc >= 3)
+        boardsPerThread = std::stoul(argv[2]);
+    if (argc >= 4)
+        rounds = std::stol(argv[3]);
+    benchmark_scaling(std::max(maxThreads, 1), boardsPerThread, rounds);
+}
+
+#endif
@@ -0,0 +1,773 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cerrno>
+#include <csignal>          // std::signal
+#include <fcntl.h>          // fcntl
+#include <sys/epoll.h>      // epoll_*
+#include <sys/socket.h>     // socket
+                            // bind
+                            // listen
+                            // accept4
+                            // connect
+#include <sys/timerfd.h>    // timerfd_*
+#include <sys/un.h>         // sockaddr_un
+#include <unistd.h>         // read
+                            // write
+                            // close
+                            // unlink
+
+// The server hosts any number of independent chess clocks, one for
+// each client connected to its Unix domain socket. A client sends the
+// same single character commands as typed into `runChessClock` (any
+// other characters like newlines are ignored) and gets one line back
+// per command:
+//
+//      +               the command was accepted
+//      -               the command was ignored in the current state
+//      B: 29:59.9*| W: 30:00.0     (reply to `?`, the current clocks)
+//
+// and `.` closes the connection. The clocks of all boards with an
+// active player are advanced every 100ms (by a timer in the same event
+// loop, so there is no need for locks).
+//
+// A client that sends commands but does not read the replies must not
+// make the server buffer them without limit: once `MaxPendingOutput`
+// bytes of replies are pending, no more input is read from it until
+// they have all been written.
+
+bool make_address(const char* path, sockaddr_un& address) {
+    address = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+    if (std::string{path}.size() >= sizeof address.sun_path)
+        return false;
+    std::copy(path, path + std::string{path}.size(), address.sun_path);
+    return true;
+}
+
+class BoardServer {
+    struct Connection {
+        int fd;
+        ChessClock board{};
+        std::string out{};      // replies not yet written
+        bool closing{};
+        bool inputPaused{};     // (too many replies not yet written)
+        explicit Connection(int connected) : fd{connected} { out.reserve(256); }
+    };
+    int listen_fd_{-1};
+    int epoll_fd_{-1};
+    int timer_fd_{-1};
+    std::vector<std::unique_ptr<Connection>> connections_{}; // (by fd)
+    long long commands_{};
+    long long ticks_{};
+    void accept_clients();
+    void handle_input(Connection&);
+    void flush_output(Connection&);
+    void close_connection(Connection&);
+    void tick_all(std::uint64_t ticks);
+public:
+    static std::atomic<bool> stopping;
+    static constexpr std::size_t MaxPendingOutput{64*1024};
+    explicit BoardServer(const char* path);
+    BoardServer(const BoardServer&)            =delete;
+    BoardServer& operator=(const BoardServer&) =delete;
+    ~BoardServer();
+    explicit operator bool() const { return timer_fd_ != -1; }
+    void run();
+    long long commands() const { return commands_; }
+};
+
+std::atomic<bool> BoardServer::stopping{};
+
+BoardServer::BoardServer(const char* path) {
+    sockaddr_un address{};
+    if (!make_address(path, address))
+        return;
+    ::unlink(path);
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if ((listen_fd_ == -1)
+     || (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+                sizeof address) == -1)
+     || (::listen(listen_fd_, SOMAXCONN) == -1))
+        return;
+    epoll_fd_ = ::epoll_create1(0);
+    if (epoll_fd_ == -1)
+        return;
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event);
+    timer_fd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if (timer_fd_ == -1)
+        return;
+    itimerspec const every_100ms{{0, 100'000'000}, {0, 100'000'000}};
+    ::timerfd_settime(timer_fd_, 0, &every_100ms, nullptr);
+    event.data.fd = timer_fd_;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &event);
+}
+
+BoardServer::~BoardServer() {
+    for (auto& c : connections_)
+        if (c) ::close(c->fd);
+    for (auto fd : {timer_fd_, epoll_fd_, listen_fd_})
+        if (fd != -1) ::close(fd);
+}
+
+void BoardServer::run() {
+    epoll_event events[256];
+    while (!stopping) {
+        int const n{::epoll_wait(epoll_fd_, events, 256, 100)};
+        for (int i{}; i < n; ++i) {
+            int const fd{events[i].data.fd};
+            if (fd == listen_fd_)
+                accept_clients();
+            else if (fd == timer_fd_) {
+                std::uint64_t expired{};
+                if (::read(timer_fd_, &expired, sizeof expired) > 0)
+                    tick_all(expired);
+            }
+            else if (auto& c{connections_[fd]}) {
+                if (events[i].events & EPOLLIN)
+                    handle_input(*c);
+                if (c && (events[i].events & (EPOLLOUT|EPOLLHUP|EPOLLERR)))
+                    flush_output(*c);
+            }
+        }
+    }
+}
+
+void BoardServer::accept_clients() {
+    for (;;) {
+        int const fd{::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK)};
+        if (fd == -1)
+            return; // (EAGAIN: all pending clients accepted)
+        if (static_cast<std::size_t>(fd) >= connections_.size())
+            connections_.resize(fd + 1);
+        connections_[fd] = std::make_unique<Connection>(fd);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+void BoardServer::handle_input(Connection& c) {
+    char buffer[4096];
+    auto const n{::read(c.fd, buffer, sizeof buffer)};
+    if ((n == 0) || ((n == -1) && (errno != EAGAIN))) {
+        close_connection(c);
+        return;
+    }
+    for (auto p{buffer}; p < buffer + n; ++p) {
+        char const command = std::tolower(static_cast<unsigned char>(*p));
+        if (!is_command(command) || c.closing)
+            continue;
+        ++commands_;
+        switch (command) {
+        case '?': {
+            std::ostringstream status{};
+            c.board.show(status);
+            auto line{status.str()};
+            c.out.append(line, 0, line.find('\n') + 1);
+            break;
+        }
+        case '.':
+            c.closing = true;
+            break;
+        default:
+            c.out.append(c.board.process(command) ? "+\n" : "-\n");
+        }
+    }
+    flush_output(c);
+}
+
+void BoardServer::flush_output(Connection& c) {
+    std::size_t written{};
+    while (written < c.out.size()) {
+        auto const n{::write(c.fd, c.out.data() + written,
+                             c.out.size() - written)};
+        if ((n == -1) && (errno != EAGAIN)) {
+            close_connection(c); // (eg. the client is gone)
+            return;
+        }
+        if (n <= 0)
+            break;
+        written += n;
+    }
+    c.out.erase(0, written);
+    if (c.out.empty() && c.closing) {
+        close_connection(c);
+        return;
+    }
+    if (c.out.size() >= MaxPendingOutput)
+        c.inputPaused = true;
+    else if (c.out.empty())
+        c.inputPaused = false;
+    // only wait for the socket being writable while output is pending,
+    // and only for input while not too much of it is pending
+    epoll_event event{};
+    if (!c.inputPaused)
+        event.events |= EPOLLIN;
+    if (!c.out.empty())
+        event.events |= EPOLLOUT;
+    event.data.fd = c.fd;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, c.fd, &event);
+}
+
+void BoardServer::close_connection(Connection& c) {
+    int const fd{c.fd};
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections_[fd].reset();
+}
+
+void BoardServer::tick_all(std::uint64_t ticks) {
+    for (auto& c : connections_) {
+        if (!c)
+            continue;
+        for (auto t{ticks}; t > 0; --t)
+            c->board.process('1');
+    }
+    ticks_ += ticks;
+}
+
+// The load generator opens `connections` clients, sends commands at
+// `rate` commands per second (in total, spread round robin over the
+// connections) for `seconds`, and measures the time from sending a
+// command to receiving its reply. To keep the measurement itself from
+// allocating, each connection remembers the send times of at most
+// `MaxInFlight` commands; while that many are outstanding no further
+// commands are sent over it (and counted as "throttled").
+
+struct LoadResult {
+    int connected{};
+    long long sent{};
+    long long replies{};
+    long long throttled{};
+    double seconds{};
+    std::vector<std::uint32_t> latencies{}; // (nanoseconds)
+    void show(std::ostream&);
+};
+
+void LoadResult::show(std::ostream& os) {
+    os << "connections:   " << connected << '\n'
+       << "commands sent: " << sent << " (" << throttled << " throttled)\n"
+       << "replies:       " << replies << '\n'
+       << "commands/s:    " << replies / seconds << '\n';
+    if (latencies.empty())
+        return;
+    std::sort(latencies.begin(), latencies.end());
+    auto const percentile = [this](double p) {
+        return latencies[static_cast<std::size_t>(p * (latencies.size()-1))]
+                / 1000.0;
+    };
+    os << "latency us:    p50=" << percentile(0.5)
+       << " p90=" << percentile(0.9)
+       << " p99=" << percentile(0.99)
+       << " p99.9=" << percentile(0.999)
+       << " max=" << latencies.back() / 1000.0 << std::endl;
+}
+
+LoadResult generate_load(const char* path, int connections,
+                         double rate, double seconds) {
+    using std::chrono::steady_clock;
+    constexpr int MaxInFlight{16};
+    struct Client {
+        int fd{-1};
+        steady_clock::time_point sentAt[MaxInFlight];
+        int first{}, inFlight{};
+    };
+    LoadResult result{};
+    sockaddr_un address{};
+    if (!make_address(path, address))
+        return result;
+    int const epoll_fd{::epoll_create1(0)};
+    std::vector<Client> clients(connections);
+    for (int i{}; i < connections; ++i) {
+        int const fd{::socket(AF_UNIX, SOCK_STREAM, 0)};
+        if ((fd == -1)
+         || (::connect(fd, reinterpret_cast<sockaddr*>(&address),
+                       sizeof address) == -1)) {
+            if (fd != -1) ::close(fd);
+            std::cerr << "connected only " << i << " clients" << std::endl;
+            clients.resize(i);
+            break;
+        }
+        ::fcntl(fd, F_SETFL, O_NONBLOCK);
+        clients[i].fd = fd;
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+    result.connected = clients.size();
+    result.latencies.reserve(static_cast<std::size_t>(rate * seconds) + 1);
+    std::mt19937 rng{};
+    static const char alphabet[]{"rspcxxx0011223"};
+    std::uniform_int_distribution<int> pick{0, sizeof alphabet - 2};
+    auto const receive = [&](Client& c) {
+        char buffer[4096];
+        auto const n{::read(c.fd, buffer, sizeof buffer)};
+        auto const now{steady_clock::now()};
+        for (auto p{buffer}; p < buffer + n; ++p) {
+            if ((*p != '\n') || (c.inFlight == 0))
+                continue;
+            result.latencies.push_back(static_cast<std::uint32_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    now - c.sentAt[c.first]).count()));
+            c.first = (c.first + 1) % MaxInFlight;
+            --c.inFlight;
+            ++result.replies;
+        }
+    };
+    epoll_event events[256];
+    auto const start{steady_clock::now()};
+    auto const end{start + std::chrono::duration_cast<steady_clock::duration>(
+                                std::chrono::duration<double>{seconds})};
+    std::size_t next{};
+    for (auto now{start}; (now < end) && !clients.empty();
+                          now = steady_clock::now()) {
+        std::chrono::duration<double> const elapsed{now - start};
+        auto const due{static_cast<long long>(rate * elapsed.count())};
+        while (result.sent + result.throttled < due) {
+            auto& c{clients[next]};
+            next = (next + 1) % clients.size();
+            if (c.inFlight == MaxInFlight) {
+                ++result.throttled;
+                continue;
+            }
+            char const command[2]{alphabet[pick(rng)], '\n'};
+            if (::write(c.fd, command, 2) != 2) {
+                ++result.throttled;
+                continue;
+            }
+            c.sentAt[(c.first + c.inFlight) % MaxInFlight] = now;
+            ++c.inFlight;
+            ++result.sent;
+        }
+        int const n{::epoll_wait(epoll_fd, events, 256, 1)};
+        for (int i{}; i < n; ++i)
+            receive(clients[events[i].data.u32]);
+    }
+    // collect the outstanding replies (for at most one second)
+    auto const drain_end{steady_clock::now() + std::chrono::seconds{1}};
+    while ((result.replies < result.sent)
+        && (steady_clock::now() < drain_end)) {
+        int const n{::epoll_wait(epoll_fd, events, 256, 10)};
+        for (int i{}; i < n; ++i)
+            receive(clients[events[i].data.u32]);
+    }
+    result.seconds = std::chrono::duration<double>{
+                        steady_clock::now() - start}.count();
+    for (auto& c : clients)
+        ::close(c.fd);
+    ::close(epoll_fd);
+    return result;
+}
+
+#if 0
+
+#include <cassert>
+#include <thread>
+
+// A client that writes without reading gets blocked (the server stops
+// reading from it), and once it reads all replies arrive.
+
+void test_slow_reader(const char* path) {
+    sockaddr_un address{};
+    make_address(path, address);
+    int const fd{::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0)};
+    assert(::connect(fd, reinterpret_cast<sockaddr*>(&address),
+                     sizeof address) == 0);
+    std::string const commands(4096, 'x'); // (each is answered by "-\n")
+    long long sent{};
+    while (sent < 64*1024*1024) {
+        auto n{::write(fd, commands.data(), commands.size())};
+        if (n == -1) {
+            assert(errno == EAGAIN);
+            std::this_thread::sleep_for(std::chrono::milliseconds{100});
+            if (::write(fd, commands.data(), 1) == -1)
+                break; // (still blocked: the server stopped reading)
+            n = 1;
+        }
+        sent += n;
+    }
+    assert(sent < 64*1024*1024);
+    long long received{};
+    char buffer[4096];
+    while (received < 2*sent) {
+        auto const n{::read(fd, buffer, sizeof buffer)};
+        if (n > 0)
+            received += n;
+        else {
+            assert(errno == EAGAIN);
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    }
+    assert(received == 2*sent);
+    ::close(fd);
+}
+
+void test_server() {
+    char const path[]{"/tmp/Step_12k_test.socket"};
+    BoardServer server{path};
+    assert(server);
+    std::thread serverThread{[&server]{ server.run(); }};
+    sockaddr_un address{};
+    make_address(path, address);
+    int const fd{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    assert(::connect(fd, reinterpret_cast<sockaddr*>(&address),
+                     sizeof address) == 0);
+    std::string const commands{"s\nr\ns\n5\n?\n."};
+    assert(::write(fd, commands.data(), commands.size())
+                == static_cast<ssize_t>(commands.size()));
+    std::string replies{};
+    char buffer[256];
+    for (ssize_t n; (n = ::read(fd, buffer, sizeof buffer)) > 0; )
+        replies.append(buffer, n);
+    ::close(fd);
+    // (the timer may tick the white player clock once or twice)
+    std::string const expected{"-\n+\n+\n+\nB: 30:00.0 | W: 2"};
+    assert(replies.compare(0, expected.size(), expected) == 0);
+    auto const load{generate_load(path, 100, 10'000, 0.5)};
+    assert(load.connected == 100);
+    assert(load.replies == load.sent);
+    test_slow_reader(path);
+    BoardServer::stopping = true;
+    serverThread.join();
+    ::unlink(path);
+}
+
+int main() {
+    test_server();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+// Usage: Step_12k --server socket-path
+//        Step_12k --load socket-path connections rate seconds
+
+int main(int argc, char* argv[]) {
+    if ((argc == 3) && (std::string{argv[1]} == "--server")) {
+        BoardServer server{argv[2]};
+        if (!server) {
+            std::cerr << "cannot listen on: " << argv[2] << std::endl;
+            return 1;
+        }
+        std::signal(SIGINT, [](int){ BoardServer::stopping = true; });
+        std::signal(SIGTERM, [](int){ BoardServer::stopping = true; });
+        std::signal(SIGPIPE, SIG_IGN);
+        std::cout << "*** serving chess clocks on " << argv[2]
+                  << " (Ctrl-C to stop)" << std::endl;
+        server.run();
+        std::cout << "*** " << server.commands() << " commands processed"
+                  << std::endl;
+        ::unlink(argv[2]);
+        return 0;
+    }
+    if ((argc == 6) && (std::string{argv[1]} == "--load")) {
+        std::signal(SIGPIPE, SIG_IGN);
+        auto result{generate_load(argv[2], std::stoi(argv[3]),
+                                  std::stod(argv[4]), std::stod(argv[5]))};
+        result.show(std::cout);
+        return 0;
+    }
+    std::cerr << "usage: " << argv[0] << " --server socket-path\n"
+                 "       " << argv[0]
+              << " --load socket-path connections rate seconds" << std::endl;
+    return 1;
+}
+
+#endif
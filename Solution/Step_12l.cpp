@@ -0,0 +1,685 @@
+#include <algorithm> // std::min
+                     // std::count
+                     // std::clamp
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    bool process(char command);
+    bool advance(int ticks); // (the clock of the active player)
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            return advance(ticksToSimulate);
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool ChessClock::advance(int ticks) {
+    switch (theGameState_) {
+    case GameState::BlackDraw:
+        blackPlayerClock_ -= ticks;
+        if (!blackPlayerClock_)
+            theGameState_ = GameState::WhiteWins;
+        break;
+    case GameState::WhiteDraw:
+        whitePlayerClock_ -= ticks;
+        if (!whitePlayerClock_)
+            theGameState_ = GameState::BlackWins;
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+#include <cstdint>
+#include <cstring>  // std::memcpy
+#include <vector>
+
+// Binary protocol: a frame starts with its payload length (in bytes,
+// 32 bit) followed by any number of fixed size command entries, each
+// addressing a board of the server by its id:
+//
+//      +----------+----------+---------+----------+
+//      | board id | command  | (unused)|  ticks   |
+//      |  32 bit  |  8 bit   |  8 bit  |  16 bit  |
+//      +----------+----------+---------+----------+
+//
+// The command is one of the characters as typed into `runChessClock`
+// or `t`, which advances the active player's clock by `ticks` (instead
+// of the fixed amounts of the digit commands). The reply to a frame
+// is a frame with one byte per command entry, `+` if the command was
+// accepted and `-` if it was ignored (or the board id is invalid).
+// All values are in host byte order (the protocol is meant for local
+// connections only). A frame length which is not a multiple of the
+// entry size or larger than `MaxFrameLength` is a protocol error,
+// after which the connection is closed.
+
+struct CommandEntry {
+    std::uint32_t board;
+    char command;
+    std::uint8_t unused;
+    std::uint16_t ticks;
+};
+static_assert(sizeof(CommandEntry) == 8, "unexpected padding");
+
+using FrameLength = std::uint32_t;
+
+constexpr FrameLength MaxFrameLength{(1u<<17) * sizeof(CommandEntry)};
+
+bool is_valid_frame_length(FrameLength length) {
+    return (length <= MaxFrameLength)
+        && (length % sizeof(CommandEntry) == 0);
+}
+
+void append_frame(std::vector<char>& out,
+                  const CommandEntry* entries, std::size_t count) {
+    FrameLength const length = count * sizeof(CommandEntry);
+    auto const at{out.size()};
+    out.resize(at + sizeof length + length);
+    std::memcpy(out.data() + at, &length, sizeof length);
+    std::memcpy(out.data() + at + sizeof length, entries, length);
+}
+
+// Calls `handle_entry(entry)` for all entries of all complete frames
+// in [data, data+size) and `end_of_frame()` after each frame; returns
+// the number of bytes consumed (ie. an incomplete frame at the end is
+// left to be completed by the next receive), or `InvalidFrame` if a
+// frame length is invalid (the frames before it are handled). Entries
+// are not copied out of the receive buffer other than loading them
+// into registers.
+
+constexpr std::size_t InvalidFrame{~std::size_t{}};
+
+template<typename HandleEntry, typename EndOfFrame>
+std::size_t parse_frames(const char* data, std::size_t size,
+                         HandleEntry handle_entry, EndOfFrame end_of_frame) {
+    std::size_t consumed{};
+    while (size - consumed >= sizeof(FrameLength)) {
+        FrameLength length;
+        std::memcpy(&length, data + consumed, sizeof length);
+        if (!is_valid_frame_length(length))
+            return InvalidFrame;
+        if (size - consumed - sizeof length < length)
+            break;
+        auto p{data + consumed + sizeof length};
+        for (auto const end{p + length}; p != end;
+                                         p += sizeof(CommandEntry)) {
+            CommandEntry entry;
+            std::memcpy(&entry, p, sizeof entry);
+            handle_entry(entry);
+        }
+        end_of_frame();
+        consumed += sizeof length + length;
+    }
+    return consumed;
+}
+
+// All boards of a server, addressed by their index.
+
+class BoardTable {
+    std::vector<ChessClock> boards_;
+public:
+    explicit BoardTable(std::size_t count) : boards_(count) {}
+    bool process(const CommandEntry& entry) {
+        if (entry.board >= boards_.size())
+            return false;
+        auto& board{boards_[entry.board]};
+        if (entry.command == 't')
+            return board.advance(entry.ticks);
+        return board.process(entry.command);
+    }
+};
+
+// Processes the complete frames in [data, data+size) with `table` and
+// appends a reply frame for each to `replies`; returns the number of
+// bytes consumed (or `InvalidFrame`).
+
+std::size_t process_frames(BoardTable& table, const char* data,
+                           std::size_t size, std::vector<char>& replies) {
+    std::size_t at{replies.size()};
+    return parse_frames(data, size,
+        [&](const CommandEntry& entry) {
+            if (replies.size() == at)
+                replies.resize(at + sizeof(FrameLength));
+            replies.push_back(table.process(entry) ? '+' : '-');
+        },
+        [&]{
+            if (replies.size() == at) // (empty frame)
+                replies.resize(at + sizeof(FrameLength));
+            FrameLength const length = replies.size() - at
+                                     - sizeof(FrameLength);
+            std::memcpy(replies.data() + at, &length, sizeof length);
+            at = replies.size();
+        });
+}
+
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include <sys/socket.h> // socketpair
+                        // shutdown
+#include <unistd.h>     // read
+                        // write
+                        // close
+
+// Writes all of [data, data+size) to `fd`.
+void write_all(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        auto const n{::write(fd, data, size)};
+        if (n <= 0)
+            return;
+        data += n;
+        size -= n;
+    }
+}
+
+// Reads from `fd` until `expected` bytes arrived (or EOF).
+void read_replies(int fd, std::size_t expected) {
+    char buffer[1<<12];
+    while (expected > 0) {
+        auto const n{::read(fd, buffer,
+                            std::min(expected, sizeof buffer))};
+        if (n <= 0)
+            return;
+        expected -= n;
+    }
+}
+
+// Server side of the benchmarks: reads requests from `fd` until EOF,
+// processes them with `process(data, size, replies)` which returns
+// the number of bytes consumed and appends the replies. The receive
+// buffer grows if it is filled by an incomplete request (the size of
+// frames is limited, so it can not grow without bounds). On a protocol
+// error the connection is shut down, so the client sees EOF.
+
+template<typename Process>
+void serve(int fd, Process process) {
+    std::vector<char> in(1<<16), replies{};
+    std::size_t filled{};
+    for (;;) {
+        if (filled == in.size())
+            in.resize(2 * in.size());
+        auto const n{::read(fd, in.data() + filled, in.size() - filled)};
+        if (n <= 0)
+            return;
+        filled += n;
+        replies.clear();
+        auto const consumed{process(in.data(), filled, replies)};
+        write_all(fd, replies.data(), replies.size());
+        if (consumed == InvalidFrame) {
+            std::cerr << "protocol error: invalid frame length" << std::endl;
+            ::shutdown(fd, SHUT_RDWR);
+            return;
+        }
+        std::memmove(in.data(), in.data() + consumed, filled - consumed);
+        filled -= consumed;
+    }
+}
+
+struct BenchmarkResult {
+    double commandsPerSecond;
+    double framesPerSecond;
+};
+
+// Client side of the benchmarks: sends `requests` in messages of
+// `requestBytes` and waits for the reply of `replyBytes` to each
+// before sending the next (ie. a client that needs to know whether
+// its command was accepted before it continues).
+
+template<typename Process>
+BenchmarkResult run_benchmark(const std::vector<char>& requests,
+                              std::size_t requestBytes, std::size_t replyBytes,
+                              int commandsPerMessage, Process process) {
+    int fds[2];
+    ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    std::thread server{[fd = fds[1], process]{ serve(fd, process); }};
+    using std::chrono::steady_clock;
+    auto const start{steady_clock::now()};
+    long long messages{};
+    for (std::size_t at{}; at < requests.size(); at += requestBytes) {
+        write_all(fds[0], requests.data() + at, requestBytes);
+        read_replies(fds[0], replyBytes);
+        ++messages;
+    }
+    std::chrono::duration<double> const elapsed{steady_clock::now() - start};
+    ::shutdown(fds[0], SHUT_WR);
+    server.join();
+    ::close(fds[0]);
+    ::close(fds[1]);
+    return {messages * commandsPerMessage / elapsed.count(),
+            messages / elapsed.count()};
+}
+
+// Compares the line oriented protocol of Step 12k (one board only, as
+// the text protocol has no board ids, a command and a newline per
+// request, a line per reply) with binary frames of `perFrame` commands
+// addressed to `boards` different boards, both over a socket pair. As
+// the client waits for each reply the difference is mostly the number
+// of system calls and context switches per command.
+
+void benchmark_protocols(long long commands, int perFrame, int boards) {
+    static const char alphabet[]{"rspcxxx0011223"};
+    std::mt19937 rng{};
+    std::uniform_int_distribution<int> pick{0, sizeof alphabet - 2};
+    std::uniform_int_distribution<std::uint32_t> board{0, boards - 1u};
+
+    std::vector<char> text{};
+    text.reserve(2 * commands);
+    for (long long i{}; i < commands; ++i) {
+        text.push_back(alphabet[pick(rng)]);
+        text.push_back('\n');
+    }
+    ChessClock single{};
+    auto const textResult{run_benchmark(text, 2, 2, 1,
+        [&single](const char* data, std::size_t size,
+                  std::vector<char>& replies) {
+            for (auto p{data}; p != data + size; ++p) {
+                char const command = std::tolower(
+                                         static_cast<unsigned char>(*p));
+                if (!is_command(command))
+                    continue;
+                replies.push_back(single.process(command) ? '+' : '-');
+                replies.push_back('\n');
+            }
+            return size;
+        })};
+
+    std::vector<char> binary{};
+    std::vector<CommandEntry> frame(perFrame);
+    auto const frames{(commands + perFrame - 1) / perFrame};
+    for (long long f{}; f < frames; ++f) {
+        for (auto& e : frame)
+            e = CommandEntry{board(rng), alphabet[pick(rng)], 0, 0};
+        append_frame(binary, frame.data(), frame.size());
+    }
+    BoardTable table(boards);
+    auto const binaryResult{run_benchmark(binary,
+        sizeof(FrameLength) + perFrame*sizeof(CommandEntry),
+        sizeof(FrameLength) + perFrame, perFrame,
+        [&table](const char* data, std::size_t size,
+                std::vector<char>& replies) {
+            return process_frames(table, data, size, replies);
+        })};
+
+    std::cout << "text lines:    " << textResult.commandsPerSecond
+              << " commands/s (= frames/s)\n"
+              << "binary frames: " << binaryResult.commandsPerSecond
+              << " commands/s, " << binaryResult.framesPerSecond
+              << " frames/s (" << perFrame << " commands per frame)"
+              << std::endl;
+}
+
+#if 0
+
+#include <cassert>
+
+void test_frames() {
+    CommandEntry const first[]{{0, 'r', 0, 0}, {0, 's', 0, 0},
+                               {0, 't', 0, 600}, {7, 'r', 0, 0}};
+    CommandEntry const second[]{{0, 'x', 0, 0}, {1, 's', 0, 0}};
+    std::vector<char> stream{};
+    append_frame(stream, first, 4);
+    append_frame(stream, second, 2);
+    BoardTable table{2};
+    std::string results{};
+    int frames{};
+    auto const handle = [&](const CommandEntry& e) {
+        results += table.process(e) ? '+' : '-';
+    };
+    auto const end_of_frame = [&]{ ++frames; results += '|'; };
+    // a partial frame is left in the buffer
+    assert(parse_frames(stream.data(), 4 + 4*8 - 1,
+                        handle, end_of_frame) == 0);
+    assert(parse_frames(stream.data(), stream.size() - 1,
+                        handle, end_of_frame) == 4 + 4*8);
+    assert(results == "+++-|");
+    assert(parse_frames(stream.data() + 4 + 4*8, 4 + 2*8,
+                        handle, end_of_frame) == 4 + 2*8);
+    assert(results == "+++-|+-|");
+    assert(frames == 2);
+}
+
+void test_invalid_frames() {
+    auto const count = [](FrameLength length) {
+        char data[sizeof length];
+        std::memcpy(data, &length, sizeof length);
+        return parse_frames(data, sizeof data,
+                            [](const CommandEntry&) {}, []{});
+    };
+    assert(count(0) == sizeof(FrameLength));
+    assert(count(8) == 0); // (incomplete)
+    assert(count(7) == InvalidFrame);
+    assert(count(MaxFrameLength + sizeof(CommandEntry)) == InvalidFrame);
+}
+
+// Sends a frame larger than the initial receive buffer of `serve`
+// followed by an invalid one, over a socket pair.
+
+void test_serve_large_frame() {
+    int fds[2];
+    assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    BoardTable table{1};
+    std::thread server{[fd = fds[1], &table]{
+        serve(fd, [&table](const char* data, std::size_t size,
+                           std::vector<char>& replies) {
+            return process_frames(table, data, size, replies);
+        });
+    }};
+    std::vector<CommandEntry> entries(20'000, CommandEntry{0, 'x', 0, 0});
+    entries[0].command = 'r';
+    entries[1].command = 's';
+    std::vector<char> request{};
+    append_frame(request, entries.data(), entries.size());
+    assert(request.size() > (1<<16));
+    FrameLength const invalid{7};
+    request.resize(request.size() + sizeof invalid);
+    std::memcpy(request.data() + request.size() - sizeof invalid,
+                &invalid, sizeof invalid);
+    std::thread client{[fd = fds[0], &request]{
+        write_all(fd, request.data(), request.size());
+    }};
+    std::vector<char> reply{};
+    char buffer[1<<12];
+    for (ssize_t n; (n = ::read(fds[0], buffer, sizeof buffer)) > 0; )
+        reply.insert(reply.end(), buffer, buffer + n);
+    client.join();
+    server.join();
+    ::close(fds[0]);
+    ::close(fds[1]);
+    // the reply to the large frame, then EOF after the invalid one
+    assert(reply.size() == sizeof(FrameLength) + entries.size());
+    FrameLength length;
+    std::memcpy(&length, reply.data(), sizeof length);
+    assert(length == entries.size());
+    assert(std::count(reply.begin() + sizeof length, reply.end(), '+')
+                == static_cast<long>(entries.size()));
+}
+
+int main() {
+    test_frames();
+    test_invalid_frames();
+    test_serve_large_frame();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <string>
+
+// Usage: Step_12l [commands [commands-per-frame [boards]]]
+
+int main(int argc, char* argv[]) {
+    long long commands{200'000};
+    int perFrame{256};
+    int boards{1000};
+    if (argc >= 2)
+        commands = std::stoll(argv[1]);
+    if (argc >= 3)
+        perFrame = std::clamp(std::stoi(argv[2]), 1, static_cast<int>(
+                                MaxFrameLength / sizeof(CommandEntry)));
+    if (argc >= 4)
+        boards = std::max(1, std::stoi(argv[3]));
+    benchmark_protocols(commands, perFrame, boards);
+}
+
+#endif
@@ -0,0 +1,736 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    int blackTime() const { return blackPlayerClock_.get(); }
+    int whiteTime() const { return whitePlayerClock_.get(); }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+
+#include <algorithm>    // std::sort
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>      // O_CREAT
+                        // O_RDWR
+                        // O_RDONLY
+#include <sys/mman.h>   // shm_open
+                        // mmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // ftruncate
+                        // close
+
+// Instead of formatting text for a display device the state of all
+// boards is published in a POSIX shared memory segment, from which any
+// number of display processes can read it with plain loads (ie. with
+// no system call and nothing to parse). The layout is versioned:
+//
+//  - a header (one cache line) with a magic number, the layout version,
+//    the number of boards and the size of each board entry, followed by
+//  - one entry per board (each on a cache line of its own, so that the
+//    writer updating one board does not disturb readers of another).
+//
+// Every board entry is guarded by a sequence lock as in Step 12i: its
+// sequence number is odd while the values are updated and a reader
+// retries until it sees the same even number before and after reading
+// them. The writer stores the magic number last, so a reader never
+// sees a half initialized segment. (All members are lock-free atomics
+// which work across processes as well as across threads.)
+
+constexpr std::uint32_t SharedMagic{0x6b636c63}; // "clck"
+constexpr std::uint32_t SharedVersion{1};
+
+struct alignas(64) SharedHeader {
+    std::atomic<std::uint32_t> magic;
+    std::uint32_t version;
+    std::uint32_t boardCount;
+    std::uint32_t boardSize;
+};
+
+struct alignas(64) SharedBoard {
+    std::atomic<std::uint32_t> sequence;
+    std::atomic<std::uint32_t> state;
+    std::atomic<std::int32_t> blackTime;
+    std::atomic<std::int32_t> whiteTime;
+    std::atomic<std::int64_t> publishedAt; // (steady clock, nanoseconds)
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free
+           && std::atomic<std::int64_t>::is_always_lock_free,
+              "shared memory requires address free atomics");
+static_assert(sizeof(SharedHeader) == 64 && sizeof(SharedBoard) == 64,
+              "unexpected layout");
+
+struct BoardView {
+    std::uint32_t sequence;
+    GameState state;
+    int blackTime;
+    int whiteTime;
+    std::int64_t publishedAt;
+};
+
+std::int64_t steady_nanoseconds() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+                steady_clock::now().time_since_epoch()).count();
+}
+
+class SharedBoards {
+    void* data_{MAP_FAILED};
+    std::size_t size_{};
+    SharedHeader& header() const { return *static_cast<SharedHeader*>(data_); }
+    SharedBoard* boards() const {
+        return reinterpret_cast<SharedBoard*>(&header() + 1);
+    }
+    bool map(int fd, std::size_t size, int protection);
+public:
+    static std::size_t segment_size(std::uint32_t count) {
+        return sizeof(SharedHeader) + count * sizeof(SharedBoard);
+    }
+    // creates (or replaces) the segment `name` for `count` boards
+    SharedBoards(const char* name, std::uint32_t count);
+    // maps the existing segment `name` read only (fails if its
+    // layout is not the one this reader understands)
+    explicit SharedBoards(const char* name);
+    SharedBoards(const SharedBoards&)            =delete;
+    SharedBoards& operator=(const SharedBoards&) =delete;
+    ~SharedBoards();
+    explicit operator bool() const { return data_ != MAP_FAILED; }
+    std::uint32_t count() const { return header().boardCount; }
+    // writer side (may only be called from one thread at a time)
+    void publish(std::uint32_t board, const ChessClock&);
+    // reader side (may be called from any thread or process)
+    BoardView read(std::uint32_t board) const;
+};
+
+bool SharedBoards::map(int fd, std::size_t size, int protection) {
+    data_ = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED)
+        return false;
+    size_ = size;
+    return true;
+}
+
+SharedBoards::SharedBoards(const char* name, std::uint32_t count) {
+    ::shm_unlink(name);
+    int const fd{::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644)};
+    if (fd == -1)
+        return;
+    auto const size{segment_size(count)};
+    if (::ftruncate(fd, size) != 0) {
+        ::close(fd);
+        return;
+    }
+    if (!map(fd, size, PROT_READ | PROT_WRITE))
+        return;
+    // (the new segment is zero filled, ie. all sequence numbers are even)
+    auto& h{header()};
+    h.version = SharedVersion;
+    h.boardCount = count;
+    h.boardSize = sizeof(SharedBoard);
+    ChessClock const initial{};
+    for (std::uint32_t i{}; i < count; ++i)
+        publish(i, initial);
+    h.magic.store(SharedMagic, std::memory_order_release);
+}
+
+SharedBoards::SharedBoards(const char* name) {
+    int const fd{::shm_open(name, O_RDONLY, 0)};
+    if (fd == -1)
+        return;
+    struct stat st{};
+    if ((::fstat(fd, &st) != 0)
+     || (static_cast<std::size_t>(st.st_size) < sizeof(SharedHeader))) {
+        ::close(fd);
+        return;
+    }
+    if (!map(fd, st.st_size, PROT_READ))
+        return;
+    auto const& h{header()};
+    if ((h.magic.load(std::memory_order_acquire) != SharedMagic)
+     || (h.version != SharedVersion)
+     || (h.boardSize != sizeof(SharedBoard))
+     || (size_ < segment_size(h.boardCount))) {
+        ::munmap(data_, size_);
+        data_ = MAP_FAILED;
+    }
+}
+
+SharedBoards::~SharedBoards() {
+    if (data_ != MAP_FAILED)
+        ::munmap(data_, size_);
+}
+
+void SharedBoards::publish(std::uint32_t board, const ChessClock& clock) {
+    auto& b{boards()[board]};
+    auto const seq{b.sequence.load(std::memory_order_relaxed)};
+    b.sequence.store(seq + 1, std::memory_order_relaxed);
+    // (release: a reader seeing any new value also sees the odd number)
+    b.state.store(static_cast<std::uint32_t>(clock.state()),
+                  std::memory_order_release);
+    b.blackTime.store(clock.blackTime(), std::memory_order_release);
+    b.whiteTime.store(clock.whiteTime(), std::memory_order_release);
+    b.publishedAt.store(steady_nanoseconds(), std::memory_order_release);
+    b.sequence.store(seq + 2, std::memory_order_release);
+}
+
+BoardView SharedBoards::read(std::uint32_t board) const {
+    auto const& b{boards()[board]};
+    BoardView result;
+    std::uint32_t after;
+    do {
+        result.sequence = b.sequence.load(std::memory_order_acquire);
+        result.state = static_cast<GameState>(
+                            b.state.load(std::memory_order_acquire));
+        result.blackTime = b.blackTime.load(std::memory_order_acquire);
+        result.whiteTime = b.whiteTime.load(std::memory_order_acquire);
+        result.publishedAt = b.publishedAt.load(std::memory_order_acquire);
+        after = b.sequence.load(std::memory_order_relaxed);
+    } while ((result.sequence & 1) || (result.sequence != after));
+    return result;
+}
+
+// Formats a time in tenth seconds like `Clock` does.
+void show_time(std::ostream& os, int tenthsecs) {
+    auto const saved_fill{os.fill()};
+    os << std::setfill(' ') << std::setw(3) << tenthsecs / 600 << ':'
+       << std::setfill('0') << std::setw(2) << tenthsecs / 10 % 60 << '.'
+                            << std::setw(1) << tenthsecs % 10;
+    os.fill(saved_fill);
+}
+
+void show(std::ostream& os, const BoardView& board) {
+    os << "B:";
+    show_time(os, board.blackTime);
+    os << ((board.state == GameState::BlackDraw) ? "*" : " ") << "| W:";
+    show_time(os, board.whiteTime);
+    os << ((board.state == GameState::WhiteDraw) ? "*" : " ")
+       << "| " << to_string(board.state);
+}
+
+// Writer for the demo: `count` boards, all started and then receiving
+// a random command now and then, all advanced by one tick and
+// published every `period` (until `stopping` is set).
+
+void publish_boards(SharedBoards& shared, std::chrono::microseconds period,
+                    const std::atomic<bool>& stopping) {
+    static const char alphabet[]{"rspc"};
+    std::mt19937 rng{};
+    std::uniform_int_distribution<int> pick{0, 100*(sizeof alphabet - 1)};
+    std::vector<ChessClock> boards(shared.count());
+    for (auto& board : boards) {
+        board.process('r');
+        board.process('s');
+    }
+    auto next{std::chrono::steady_clock::now()};
+    while (!stopping.load(std::memory_order_relaxed)) {
+        for (std::uint32_t i{}; i < boards.size(); ++i) {
+            auto const p{pick(rng)};
+            if (p < static_cast<int>(sizeof alphabet - 1))
+                boards[i].process(alphabet[p]);
+            boards[i].process('1');
+            shared.publish(i, boards[i]);
+        }
+        std::this_thread::sleep_until(next += period);
+    }
+}
+
+// Reader side measurements: the cost of reading one board and the time
+// from publishing a board until a reader polling it sees the update.
+
+struct ReaderLatency {
+    double readNanoseconds{};
+    long long updates{};
+    std::vector<std::int64_t> latencies{}; // (nanoseconds)
+    void show(std::ostream&);
+};
+
+void ReaderLatency::show(std::ostream& os) {
+    os << "read ns/board: " << readNanoseconds << '\n'
+       << "updates seen:  " << updates << '\n';
+    if (latencies.empty())
+        return;
+    std::sort(latencies.begin(), latencies.end());
+    auto const percentile = [this](double p) {
+        return latencies[static_cast<std::size_t>(p * (latencies.size()-1))]
+                / 1000.0;
+    };
+    os << "visible after us: p50=" << percentile(0.5)
+       << " p90=" << percentile(0.9)
+       << " p99=" << percentile(0.99)
+       << " max=" << latencies.back() / 1000.0 << std::endl;
+}
+
+ReaderLatency measure_reader(const SharedBoards& shared, double seconds) {
+    ReaderLatency result{};
+    auto const count{shared.count()};
+    constexpr int Rounds{1000};
+    std::int64_t checksum{};
+    auto const start{steady_nanoseconds()};
+    for (int r{}; r < Rounds; ++r)
+        for (std::uint32_t i{}; i < count; ++i)
+            checksum += shared.read(i).blackTime;
+    result.readNanoseconds = double(steady_nanoseconds() - start)
+                           / (double(Rounds) * count);
+    // (on a machine with fewer cores than readers and writer a spinning
+    // reader would delay the writer, hence the yield)
+    auto const end{steady_nanoseconds() + std::int64_t(seconds * 1e9)};
+    auto last{shared.read(0).sequence};
+    while (steady_nanoseconds() < end) {
+        auto const board{shared.read(0)};
+        if (board.sequence != last) {
+            result.latencies.push_back(steady_nanoseconds()
+                                       - board.publishedAt);
+            last = board.sequence;
+            ++result.updates;
+        }
+        std::this_thread::yield();
+    }
+    if (checksum == -1)
+        std::cout << std::flush; // (keep the reads)
+    return result;
+}
+
+#if 0
+
+#include <cassert>
+#include <sstream>
+
+void test_shared_boards() {
+    char const name[]{"/Step_12m_test"};
+    assert(!SharedBoards{name});
+    SharedBoards writer{name, 3};
+    assert(writer);
+    SharedBoards const reader{name};
+    assert(reader && (reader.count() == 3));
+    auto const initial{reader.read(1)};
+    assert(initial.state == GameState::Initial);
+    assert((initial.sequence & 1) == 0);
+    ChessClock clock{};
+    clock.process('r');
+    clock.process('s');
+    clock.process('5');
+    writer.publish(1, clock);
+    auto const updated{reader.read(1)};
+    assert(updated.sequence == initial.sequence + 2);
+    assert(updated.state == GameState::WhiteDraw);
+    assert(updated.blackTime == InitialTime);
+    assert(updated.whiteTime == InitialTime - 600);
+    assert(reader.read(0).state == GameState::Initial);
+    std::ostringstream os{};
+    show(os, updated);
+    assert(os.str() == "B: 30:00.0 | W: 29:00.0*| WhiteDraw");
+    ::shm_unlink(name);
+}
+
+void test_reader_latency() {
+    char const name[]{"/Step_12m_test"};
+    SharedBoards writer{name, 10};
+    std::atomic<bool> stopping{false};
+    std::thread publisher{[&]{
+        publish_boards(writer, std::chrono::milliseconds{1}, stopping);
+    }};
+    SharedBoards const reader{name};
+    auto const result{measure_reader(reader, 0.2)};
+    stopping = true;
+    publisher.join();
+    assert(result.updates > 10);
+    assert(result.latencies.size() == std::size_t(result.updates));
+    ::shm_unlink(name);
+}
+
+void test_reader_sees_time_running() {
+    char const name[]{"/Step_12m_test"};
+    SharedBoards writer{name, 10};
+    std::atomic<bool> stopping{false};
+    std::thread publisher{[&]{
+        publish_boards(writer, std::chrono::milliseconds{1}, stopping);
+    }};
+    SharedBoards const reader{name};
+    auto const remaining = [&reader]{
+        int total{};
+        for (std::uint32_t i{}; i < reader.count(); ++i) {
+            auto const board{reader.read(i)};
+            total += board.blackTime + board.whiteTime;
+        }
+        return total;
+    };
+    // (wait until all boards are published once)
+    while (reader.read(reader.count() - 1).state == GameState::Initial)
+        std::this_thread::yield();
+    auto const before{remaining()};
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    auto const after{remaining()};
+    stopping = true;
+    publisher.join();
+    assert(after < before);
+    assert(after < static_cast<int>(reader.count()) * 2 * InitialTime);
+    ::shm_unlink(name);
+}
+
+int main() {
+    test_shared_boards();
+    test_reader_latency();
+    test_reader_sees_time_running();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <csignal>      // std::signal
+#include <string>
+
+std::atomic<bool> stopping{false};
+
+// Usage: Step_12m --publish name boards [period-ms]
+//        Step_12m --read name [board]
+//        Step_12m --latency name [seconds]
+
+int main(int argc, char* argv[]) {
+    std::signal(SIGINT, [](int){ stopping = true; });
+    std::signal(SIGTERM, [](int){ stopping = true; });
+    if (((argc == 4) || (argc == 5))
+     && (std::string{argv[1]} == "--publish")) {
+        SharedBoards shared{argv[2],
+                            static_cast<std::uint32_t>(std::stoul(argv[3]))};
+        if (!shared) {
+            std::cerr << "cannot create: " << argv[2] << std::endl;
+            return 1;
+        }
+        std::chrono::milliseconds const period{
+                                    (argc == 5) ? std::stoi(argv[4]) : 100};
+        std::cout << "*** publishing " << shared.count() << " boards in "
+                  << argv[2] << " (Ctrl-C to stop)" << std::endl;
+        publish_boards(shared, period, stopping);
+        ::shm_unlink(argv[2]);
+        return 0;
+    }
+    if (((argc == 3) || (argc == 4)) && (std::string{argv[1]} == "--read")) {
+        SharedBoards const shared{argv[2]};
+        if (!shared) {
+            std::cerr << "no (compatible) boards in: " << argv[2] << std::endl;
+            return 1;
+        }
+        std::uint32_t const board = (argc == 4) ? std::stoul(argv[3]) : 0;
+        if (board >= shared.count()) {
+            std::cerr << "no such board: " << board << std::endl;
+            return 1;
+        }
+        // (polls at the rate the clocks are updated, but the reads as
+        // such need no system call)
+        std::uint32_t last{1};
+        while (!stopping) {
+            auto const view{shared.read(board)};
+            if (view.sequence != last) {
+                std::cout << '\r';
+                show(std::cout, view);
+                std::cout << "   " << std::flush; // (longer state names)
+                last = view.sequence;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        }
+        std::cout << std::endl;
+        return 0;
+    }
+    if (((argc == 3) || (argc == 4)) && (std::string{argv[1]} == "--latency")) {
+        SharedBoards const shared{argv[2]};
+        if (!shared) {
+            std::cerr << "no (compatible) boards in: " << argv[2] << std::endl;
+            return 1;
+        }
+        auto result{measure_reader(shared, (argc == 4) ? std::stod(argv[3])
+                                                       : 5.0)};
+        result.show(std::cout);
+        return 0;
+    }
+    std::cerr << "usage: " << argv[0] << " --publish name boards [period-ms]\n"
+                 "       " << argv[0] << " --read name [board]\n"
+                 "       " << argv[0] << " --latency name [seconds]"
+              << std::endl;
+    return 1;
+}
+
+#endif
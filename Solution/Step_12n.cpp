@@ -0,0 +1,721 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    int blackTime() const { return blackPlayerClock_.get(); }
+    int whiteTime() const { return whitePlayerClock_.get(); }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>          // std::memset
+#include <vector>
+
+#include <fcntl.h>          // open
+#include <linux/io_uring.h> // io_uring_params
+                            // io_uring_sqe
+                            // io_uring_cqe
+#include <sys/mman.h>       // mmap
+#include <sys/resource.h>   // getrusage
+#include <sys/syscall.h>    // __NR_io_uring_setup
+                            // __NR_io_uring_enter
+#include <unistd.h>         // write
+                            // close
+
+// When one process drives many displays (a tty or file per board) the
+// updates of each tick cost one `write` system call per display. With
+// io_uring all the writes of a tick are put into the submission queue
+// (shared memory between process and kernel) and handed to the kernel
+// with a single system call, which also waits for their completions.
+// As io_uring may not be available (old kernels, disabled by a sysctl
+// or a seccomp filter) plain writes remain as the fallback.
+
+struct DisplayWrite {
+    int fd;
+    const char* data;
+    unsigned size;
+};
+
+class I_DisplayOutput {
+public:
+    virtual const char* name() const =0;
+    virtual void write(const std::vector<DisplayWrite>&) =0;
+    virtual long long syscalls() const =0;
+    virtual long long failures() const =0;
+};
+
+class PlainDisplayOutput : public I_DisplayOutput {
+    long long syscalls_{};
+    long long failures_{};
+public:
+    const char* name() const override { return "write"; }
+    void write(const std::vector<DisplayWrite>& writes) override {
+        for (auto const& w : writes) {
+            ++syscalls_;
+            if (::write(w.fd, w.data, w.size) != w.size)
+                ++failures_;
+        }
+    }
+    long long syscalls() const override { return syscalls_; }
+    long long failures() const override { return failures_; }
+};
+
+// The rings are set up with the raw system calls (no liburing): the
+// submission ring (head, tail and an index array), the array of
+// submission queue entries and the completion ring are mapped into the
+// process. The process only writes the submission tail and completion
+// head, the kernel the other two indices.
+
+class UringDisplayOutput : public I_DisplayOutput {
+    int ringFd_{-1};
+    unsigned entries_{};
+    void* sqRing_{MAP_FAILED};
+    std::size_t sqRingSize_{};
+    void* cqRing_{MAP_FAILED};
+    std::size_t cqRingSize_{};
+    void* sqes_{MAP_FAILED};
+    std::size_t sqesSize_{};
+    unsigned* sqTail_{};
+    unsigned sqMask_{};
+    unsigned* sqArray_{};
+    unsigned* cqHead_{};
+    unsigned* cqTail_{};
+    unsigned cqMask_{};
+    io_uring_cqe* cqes_{};
+    unsigned inFlight_{};   // submitted, completion not yet seen
+    long long syscalls_{};
+    long long failures_{};
+    void submit_and_wait(const DisplayWrite* writes, unsigned count);
+    void reap_completions();
+public:
+    explicit UringDisplayOutput(unsigned entries = 1024);
+    UringDisplayOutput(const UringDisplayOutput&)            =delete;
+    UringDisplayOutput& operator=(const UringDisplayOutput&) =delete;
+    ~UringDisplayOutput();
+    explicit operator bool() const { return sqes_ != MAP_FAILED; }
+    const char* name() const override { return "io_uring"; }
+    void write(const std::vector<DisplayWrite>&) override;
+    long long syscalls() const override { return syscalls_; }
+    long long failures() const override { return failures_; }
+};
+
+UringDisplayOutput::UringDisplayOutput(unsigned entries) {
+    io_uring_params params{};
+    ringFd_ = ::syscall(__NR_io_uring_setup, entries, &params);
+    if (ringFd_ == -1)
+        return;
+    entries_ = params.sq_entries;
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params.cq_off.cqes
+                + params.cq_entries * sizeof(io_uring_cqe);
+    bool const single{(params.features & IORING_FEAT_SINGLE_MMAP) != 0};
+    if (single)
+        sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    sqRing_ = ::mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+    if (sqRing_ == MAP_FAILED)
+        return;
+    cqRing_ = single ? sqRing_
+                     : ::mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, ringFd_,
+                              IORING_OFF_CQ_RING);
+    if (cqRing_ == MAP_FAILED)
+        return;
+    auto const sq{static_cast<char*>(sqRing_)};
+    auto const cq{static_cast<char*>(cqRing_)};
+    sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    // (mapped last, so that a successful mapping means fully set up)
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = ::mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+}
+
+UringDisplayOutput::~UringDisplayOutput() {
+    if (sqes_ != MAP_FAILED)
+        ::munmap(sqes_, sqesSize_);
+    if ((cqRing_ != MAP_FAILED) && (cqRing_ != sqRing_))
+        ::munmap(cqRing_, cqRingSize_);
+    if (sqRing_ != MAP_FAILED)
+        ::munmap(sqRing_, sqRingSize_);
+    if (ringFd_ != -1)
+        ::close(ringFd_);
+}
+
+void UringDisplayOutput::write(const std::vector<DisplayWrite>& writes) {
+    for (std::size_t done{}; done < writes.size(); ) {
+        auto const count{static_cast<unsigned>(
+                            std::min<std::size_t>(entries_,
+                                                  writes.size() - done))};
+        submit_and_wait(writes.data() + done, count);
+        done += count;
+    }
+}
+
+void UringDisplayOutput::submit_and_wait(const DisplayWrite* writes,
+                                         unsigned count) {
+    auto const entries{static_cast<io_uring_sqe*>(sqes_)};
+    auto tail{*sqTail_}; // (written by this process only)
+    for (unsigned i{}; i < count; ++i, ++tail) {
+        auto const index{tail & sqMask_};
+        auto& sqe{entries[index]};
+        std::memset(&sqe, 0, sizeof sqe);
+        sqe.opcode = IORING_OP_WRITE;
+        sqe.fd = writes[i].fd;
+        sqe.addr = reinterpret_cast<std::uintptr_t>(writes[i].data);
+        sqe.len = writes[i].size;
+        sqe.off = static_cast<std::uint64_t>(-1); // (current position)
+        sqe.user_data = writes[i].size;
+        sqArray_[index] = index;
+    }
+    __atomic_store_n(sqTail_, tail, __ATOMIC_RELEASE);
+    unsigned submitted{};
+    while (submitted < count) {
+        ++syscalls_;
+        int const n = ::syscall(__NR_io_uring_enter, ringFd_,
+                                count - submitted, count - submitted,
+                                IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        submitted += n;
+    }
+    inFlight_ += submitted;
+    if (submitted < count) {
+        // (the kernel did not consume the remaining entries, so they
+        // are taken back and written the plain way)
+        __atomic_store_n(sqTail_, tail - (count - submitted),
+                         __ATOMIC_RELEASE);
+        for (auto i{submitted}; i < count; ++i) {
+            ++syscalls_;
+            if (::write(writes[i].fd, writes[i].data, writes[i].size)
+                    != writes[i].size)
+                ++failures_;
+        }
+    }
+    reap_completions();
+    // (the buffers are reused with the next tick, so all writes need to
+    // be completed before returning; normally they are already)
+    while (inFlight_ > 0) {
+        ++syscalls_;
+        int const n = ::syscall(__NR_io_uring_enter, ringFd_, 0, inFlight_,
+                                IORING_ENTER_GETEVENTS, nullptr, 0);
+        if ((n < 0) && (errno != EINTR))
+            break;
+        reap_completions();
+    }
+}
+
+// Consumes all completions available (also those of writes submitted
+// with an earlier call, if waiting for them failed then).
+
+void UringDisplayOutput::reap_completions() {
+    auto head{*cqHead_}; // (written by this process only)
+    for (auto const ctail{__atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)};
+         head != ctail; ++head) {
+        auto const& cqe{cqes_[head & cqMask_]};
+        if (cqe.res != static_cast<std::int32_t>(cqe.user_data))
+            ++failures_;
+        --inFlight_;
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+}
+
+// Renders the line of a board as shown on its display (`\r` first, so
+// that a tty shows it in place), into a buffer of fixed size.
+
+constexpr unsigned LineSize{32};
+
+unsigned render(const ChessClock& board, char* line) {
+    auto const put_time = [](char* p, int tenthsecs) {
+        auto const minutes{tenthsecs / 600};
+        p[0] = (minutes >= 100) ? '0' + minutes / 100 : ' ';
+        p[1] = (minutes >= 10) ? '0' + minutes / 10 % 10 : ' ';
+        p[2] = '0' + minutes % 10;
+        p[3] = ':';
+        p[4] = '0' + tenthsecs / 100 % 6;
+        p[5] = '0' + tenthsecs / 10 % 10;
+        p[6] = '.';
+        p[7] = '0' + tenthsecs % 10;
+    };
+    std::memcpy(line, "\rB:         | W:          ", 26);
+    put_time(line + 3, board.blackTime());
+    put_time(line + 16, board.whiteTime());
+    line[11] = (board.state() == GameState::BlackDraw) ? '*' : ' ';
+    line[24] = (board.state() == GameState::WhiteDraw) ? '*' : ' ';
+    return 25;
+}
+
+// Drives `boards.size()` boards (each with a display of its own) for
+// `ticks` ticks, as fast as possible, and reports the system calls and
+// CPU time per tick. Each tick advances the clock of the player to
+// draw, every now and then the players switch or the game is paused
+// for a tick, and a game which has been won is started again.
+
+struct OutputCost {
+    long long syscalls{};
+    long long failures{};
+    double cpuSeconds{};
+    double seconds{};
+};
+
+double cpu_seconds() {
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    auto const seconds = [](const timeval& tv) {
+        return tv.tv_sec + tv.tv_usec / 1e6;
+    };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+OutputCost drive_displays(I_DisplayOutput& output,
+                          const std::vector<int>& displays, int ticks) {
+    std::vector<ChessClock> boards(displays.size());
+    for (auto& b : boards) {
+        b.process('r');
+        b.process('s');
+    }
+    std::vector<char> lines(boards.size() * LineSize);
+    std::vector<DisplayWrite> writes(boards.size());
+    auto const syscalls{output.syscalls()};
+    auto const failures{output.failures()};
+    auto const cpu{cpu_seconds()};
+    auto const start{std::chrono::steady_clock::now()};
+    for (int t{}; t < ticks; ++t) {
+        for (std::size_t i{}; i < boards.size(); ++i) {
+            auto& board{boards[i]};
+            switch ((t + i) % 50) {
+            case 0:  board.process('x'); break;
+            case 25: board.process('p'); break;
+            case 26: board.process('c'); break;
+            default: board.process('1');
+            }
+            if ((board.state() == GameState::WhiteWins)
+             || (board.state() == GameState::BlackWins)) {
+                board.process('r');
+                board.process('s');
+            }
+            auto const line{&lines[i * LineSize]};
+            writes[i] = {displays[i], line, render(boards[i], line)};
+        }
+        output.write(writes);
+    }
+    return {output.syscalls() - syscalls,
+            output.failures() - failures,
+            cpu_seconds() - cpu,
+            std::chrono::duration<double>{
+                std::chrono::steady_clock::now() - start}.count()};
+}
+
+void report(const char* name, const OutputCost& cost, int ticks,
+            std::size_t displays) {
+    constexpr double TicksPerSecond{10.0};
+    std::cout << name << ": " << displays << " displays, "
+              << double(cost.syscalls) / ticks << " syscalls/tick ("
+              << cost.syscalls / cost.seconds << "/s flat out, "
+              << cost.syscalls * TicksPerSecond / ticks << "/s at 10 ticks/s), "
+              << cost.cpuSeconds / ticks * 1e6 << " us CPU/tick ("
+              << cost.cpuSeconds / ticks * TicksPerSecond * 100
+              << "% at 10 ticks/s)";
+    if (cost.failures)
+        std::cout << ", " << cost.failures << " failed writes";
+    std::cout << std::endl;
+}
+
+#if 0
+
+#include <cassert>
+#include <fstream>
+#include <iterator>
+
+void test_render() {
+    ChessClock board{};
+    board.process('r');
+    board.process('s');
+    board.process('6');
+    char line[LineSize];
+    auto const n{render(board, line)};
+    assert(std::string(line, n) == "\rB: 30:00.0 | W: 25:00.0*");
+}
+
+void test_outputs() {
+    char path[]{"/tmp/Step_12n_testXXXXXX"};
+    int const fd{::mkstemp(path)};
+    assert(fd != -1);
+    ::unlink(path);
+    PlainDisplayOutput plain{};
+    UringDisplayOutput uring{8};
+    std::vector<DisplayWrite> writes{};
+    for (int i{}; i < 20; ++i)
+        writes.push_back({fd, "0123456789", 1u + i % 10});
+    plain.write(writes);
+    assert((plain.syscalls() == 20) && (plain.failures() == 0));
+    if (uring) {
+        uring.write(writes);
+        // (eight submission queue entries: three batches)
+        assert((uring.syscalls() == 3) && (uring.failures() == 0));
+        assert(::lseek(fd, 0, SEEK_CUR) == 2 * (2 * 55));
+    }
+    ::close(fd);
+    writes = {{-1, "x", 1}};
+    plain.write(writes);
+    assert(plain.failures() == 1);
+    if (uring) {
+        uring.write(writes);
+        assert(uring.failures() == 1);
+    }
+}
+
+void test_displays_change() {
+    char path[]{"/tmp/Step_12n_testXXXXXX"};
+    int const fd{::mkstemp(path)};
+    assert(fd != -1);
+    PlainDisplayOutput plain{};
+    auto const cost{drive_displays(plain, {fd}, 100)};
+    assert((cost.syscalls == 100) && (cost.failures == 0));
+    ::close(fd);
+    std::ifstream in{path};
+    std::string const written{std::istreambuf_iterator<char>{in}, {}};
+    ::unlink(path);
+    // each player drew 47 ticks (x, 24 ticks, p, c, 23 ticks, x, ...)
+    assert(written.size() == 100 * 25);
+    assert(written.substr(written.size() - 25)
+                == "\rB: 29:55.3 | W: 29:55.3*");
+}
+
+int main() {
+    test_render();
+    test_outputs();
+    test_displays_change();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <string>
+
+// Usage: Step_12n [--no-uring] [displays [ticks [path]]]
+//
+// (each display is a file descriptor of its own opened for `path`,
+// by default /dev/null)
+
+int main(int argc, char* argv[]) {
+    int arg{1};
+    bool const noUring{(argc > arg) && (std::string{argv[arg]} == "--no-uring")};
+    arg += noUring;
+    int const count{(argc > arg) ? std::stoi(argv[arg]) : 1000};
+    int const ticks{(argc > arg+1) ? std::stoi(argv[arg+1]) : 1000};
+    const char* const path{(argc > arg+2) ? argv[arg+2] : "/dev/null"};
+    std::vector<int> displays{};
+    for (int i{}; i < count; ++i) {
+        int const fd{::open(path, O_WRONLY | O_CREAT | O_APPEND, 0644)};
+        if (fd == -1) {
+            std::cerr << "cannot open display " << i << ": " << path
+                      << std::endl;
+            return 1;
+        }
+        displays.push_back(fd);
+    }
+    PlainDisplayOutput plain{};
+    report(plain.name(), drive_displays(plain, displays, ticks),
+           ticks, displays.size());
+    if (!noUring) {
+        UringDisplayOutput uring{};
+        if (uring)
+            report(uring.name(), drive_displays(uring, displays, ticks),
+                   ticks, displays.size());
+        else
+            std::cout << "io_uring not available (using "
+                      << plain.name() << ")" << std::endl;
+    }
+    for (auto const fd : displays)
+        ::close(fd);
+}
+
+#endif
@@ -0,0 +1,558 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+
+#include <algorithm>  // std::count
+#include <cerrno>
+#include <csignal>    // std::signal
+#include <memory>       // std::shared_ptr
+#include <sstream>      // std::ostringstream
+#include <vector>
+
+#include <fcntl.h>      // open
+                        // fcntl
+#include <poll.h>       // poll
+#include <sys/uio.h>    // writev
+#include <unistd.h>     // close
+
+// The status output is fanned out to any number of sinks (ttys, log
+// files, pipes). Each update is rendered once into a buffer shared by
+// all sinks and handed to each with a single `writev`, which also
+// gathers what a sink still owes from the previous update (so nothing
+// is copied per sink). All sinks are non-blocking: a sink that cannot
+// keep up does not hold up the others but is switched to latest-value
+// mode, ie. it finishes the update it is in the middle of and then
+// gets the newest one, while the updates in between are dropped.
+
+class FanOutDisplay {
+    using Buffer = std::shared_ptr<const std::string>;
+    struct Sink {
+        int fd;
+        bool owned;             // (closed by the destructor)
+        Buffer current{};       // update partially written so far
+        std::size_t offset{};   // (of the unwritten rest of `current`)
+        Buffer latest{};        // update not yet started
+        long long written{};    // (complete updates)
+        long long dropped{};    // (superseded before being started)
+        bool failed{};          // (eg. the reader of a pipe is gone)
+    };
+    std::vector<Sink> sinks_{};
+    void flush(Sink&);
+public:
+    FanOutDisplay() =default;
+    FanOutDisplay(const FanOutDisplay&)            =delete;
+    FanOutDisplay& operator=(const FanOutDisplay&) =delete;
+    ~FanOutDisplay();
+    // `path` "-" is standard output
+    bool add(const char* path);
+    // (makes `fd` non-blocking)
+    void add(int fd, bool owned = false);
+    void update(const std::string& rendered);
+    // waits at most `timeout_ms` for backlogged sinks to take their rest
+    bool drain(int timeout_ms);
+    std::size_t size() const { return sinks_.size(); }
+    long long written(std::size_t sink) const { return sinks_[sink].written; }
+    long long dropped(std::size_t sink) const { return sinks_[sink].dropped; }
+    bool failed(std::size_t sink) const { return sinks_[sink].failed; }
+};
+
+FanOutDisplay::~FanOutDisplay() {
+    for (auto const& s : sinks_)
+        if (s.owned)
+            ::close(s.fd);
+}
+
+bool FanOutDisplay::add(const char* path) {
+    if (std::string{path} == "-") {
+        // (left blocking, as the file description is shared with
+        // `std::cout` which would fail on EAGAIN)
+        sinks_.push_back({STDOUT_FILENO, false});
+        return true;
+    }
+    int const fd{::open(path, O_WRONLY | O_CREAT | O_APPEND | O_NONBLOCK,
+                        0644)};
+    if (fd == -1)
+        return false;
+    add(fd, true);
+    return true;
+}
+
+void FanOutDisplay::add(int fd, bool owned) {
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    sinks_.push_back({fd, owned});
+}
+
+void FanOutDisplay::update(const std::string& rendered) {
+    auto const buffer{std::make_shared<const std::string>(rendered)};
+    for (auto& s : sinks_) {
+        if (s.failed)
+            continue;
+        if (s.latest)
+            ++s.dropped;
+        s.latest = buffer;
+        flush(s);
+    }
+}
+
+void FanOutDisplay::flush(Sink& s) {
+    while (s.current || s.latest) {
+        iovec parts[2];
+        int count{};
+        if (s.current)
+            parts[count++] = {const_cast<char*>(s.current->data() + s.offset),
+                              s.current->size() - s.offset};
+        if (s.latest)
+            parts[count++] = {const_cast<char*>(s.latest->data()),
+                              s.latest->size()};
+        auto n{::writev(s.fd, parts, count)};
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN)
+                s.failed = true;
+            return;
+        }
+        if (s.current) {
+            auto const rest{s.current->size() - s.offset};
+            if (static_cast<std::size_t>(n) < rest) {
+                s.offset += n;
+                return;
+            }
+            n -= rest;
+            s.current.reset();
+            ++s.written;
+        }
+        if (s.latest) {
+            s.current = std::move(s.latest);
+            s.latest.reset();
+            s.offset = n;
+            if (s.offset < s.current->size())
+                return;
+            s.current.reset();
+            ++s.written;
+        }
+    }
+}
+
+bool FanOutDisplay::drain(int timeout_ms) {
+    for (;;) {
+        std::vector<pollfd> waiting{};
+        for (auto& s : sinks_)
+            if (!s.failed && (s.current || s.latest))
+                waiting.push_back({s.fd, POLLOUT, 0});
+        if (waiting.empty())
+            return true;
+        if (::poll(waiting.data(), waiting.size(), timeout_ms) <= 0)
+            return false;
+        for (auto& s : sinks_)
+            if (!s.failed && (s.current || s.latest))
+                flush(s);
+    }
+}
+
+void runChessClock(FanOutDisplay& display)
+{
+    ChessClock chessClock{};
+    std::ostringstream clkout{};
+    char command;
+    while (std::cin.get(command)) {
+        command = std::tolower(static_cast<unsigned char>(command));
+        if (is_command(command)) {
+            std::cout << "===> " << command << std::endl;
+            switch (command) {
+                case '?':
+                    std::cout << "*** Chess Clock Commands ***\n"
+                                 "r - reset player clocks to initial time\n"
+                                 "s - start the game (white draws first)\n"
+                                 "p - pause the game\n"
+                                 "c - continue the game\n"
+                                 "x - switch to the other player\n"
+                                 "0..9 - advance the active player clock\n"
+                                 "--- General Commends ---\n"
+                                 "? - show this list of commands\n"
+                                 ". - end the chess clock program\n";
+                    break;
+                case '.':
+                    std::cout << "Thanks for using the Chess-Clock" << std::endl;
+                    return;
+                default:
+                    if (!chessClock.process(command))
+                        continue;
+            }
+            // (rendered once, whatever the number of sinks)
+            clkout.str("");
+            chessClock.show(clkout);
+            display.update(clkout.str());
+        }
+    }
+}
+
+#if 0
+
+#include <cassert>
+
+void test_fan_out() {
+    int fast[2], slow[2];
+    assert(::pipe(fast) == 0);
+    assert(::pipe(slow) == 0);
+    ::fcntl(slow[1], F_SETPIPE_SZ, 4096);
+    FanOutDisplay display{};
+    display.add(fast[1], true);
+    display.add(slow[1], true);
+    constexpr int Updates{10'000};
+    std::string received{};
+    char buffer[1<<16];
+    ::fcntl(fast[0], F_SETFL, O_NONBLOCK);
+    for (int i{}; i < Updates; ++i) {
+        display.update("update " + std::to_string(i) + '\n');
+        for (ssize_t n; (n = ::read(fast[0], buffer, sizeof buffer)) > 0; )
+            received.append(buffer, n);
+    }
+    // the fast sink got everything, the slow one fell behind
+    assert(display.written(0) == Updates);
+    assert(display.dropped(0) == 0);
+    assert(display.dropped(1) > 0);
+    assert(std::count(received.begin(), received.end(), '\n') == Updates);
+    // once the slow sink is read it gets complete lines, ending with
+    // the newest update
+    std::string slowReceived{};
+    ::fcntl(slow[0], F_SETFL, O_NONBLOCK);
+    do {
+        for (ssize_t n; (n = ::read(slow[0], buffer, sizeof buffer)) > 0; )
+            slowReceived.append(buffer, n);
+    } while (!display.drain(10));
+    for (ssize_t n; (n = ::read(slow[0], buffer, sizeof buffer)) > 0; )
+        slowReceived.append(buffer, n);
+    assert(display.written(1) + display.dropped(1) == Updates);
+    assert(std::count(slowReceived.begin(), slowReceived.end(), '\n')
+                == display.written(1));
+    std::string const last{"update " + std::to_string(Updates - 1) + '\n'};
+    assert(slowReceived.compare(slowReceived.size() - last.size(),
+                                last.size(), last) == 0);
+    // a sink without reader fails, the others continue
+    ::close(fast[0]);
+    display.update("after close\n");
+    assert(display.failed(0));
+    assert(!display.failed(1));
+    ::close(slow[0]);
+}
+
+int main() {
+    std::signal(SIGPIPE, SIG_IGN);
+    test_fan_out();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+// Usage: Step_12o [sink ...]
+//
+// (each sink is a tty, a file or a named pipe, `-` is standard output,
+// which is also the default)
+
+int main(int argc, char *argv[])
+{
+    std::signal(SIGPIPE, SIG_IGN);
+    FanOutDisplay display{};
+    for (int i{1}; i < argc; ++i) {
+        if (!display.add(argv[i])) {
+            std::cerr << "cannot open: " << argv[i] << std::endl;
+            return 1;
+        }
+        std::cout << "CLOCK DISPLAY: " << argv[i] << std::endl;
+    }
+    if (display.size() == 0)
+        display.add("-");
+    display.update("*** CHESS CLOCK DISPLAY ***\n");
+    runChessClock(display);
+    display.drain(1000);
+    for (std::size_t i{}; i < display.size(); ++i)
+        if (display.dropped(i) || display.failed(i))
+            std::cout << "display " << i + 1 << ": "
+                      << display.written(i) << " updates shown, "
+                      << display.dropped(i) << " dropped"
+                      << (display.failed(i) ? " (failed)" : "") << std::endl;
+}
+
+#endif
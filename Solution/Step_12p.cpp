@@ -0,0 +1,758 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// Tracing of the FSM (compiled in only with `-DCHESS_CLOCK_TRACE`):
+// each command processed by a `ChessClock` is recorded with the state
+// before and after, whether it was accepted and both clock values into
+// a ring buffer of the calling thread. Recording is a handful of plain
+// stores (no lock, no system call, no formatting), the oldest events
+// are overwritten when the ring is full. The rings of all threads can
+// be dumped (in binary, decoded with `--decode`) on demand or by a
+// signal handler when the program crashes. Without the macro there is
+// no trace code at all, not even a check whether tracing is enabled.
+
+#ifdef CHESS_CLOCK_TRACE
+
+#include <algorithm>    // std::min
+#include <atomic>
+#include <chrono>
+#include <csignal>      // std::raise
+#include <cstdint>
+#include <cstring>      // std::strncpy
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>  // __rdtsc
+#endif
+#include <fcntl.h>      // open
+#include <unistd.h>     // write
+                        // close
+
+namespace trace {
+
+inline std::uint64_t timestamp() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+// Each event takes three words. They are written by the owning thread
+// only, with release stores (as plain as ordinary stores on x86) so
+// that a dumper in another thread can tell whether it read an event
+// that was overwritten at the same time (see `drain`).
+
+class Ring {
+public:
+    static constexpr std::uint64_t Capacity{4096}; // (a power of 2)
+    static constexpr int Words{3};
+private:
+    std::atomic<std::uint64_t> head_{}; // (events recorded so far)
+    std::atomic<std::uint64_t> slots_[Capacity][Words]{};
+public:
+    void record(std::uint64_t w0, std::uint64_t w1, std::uint64_t w2) {
+        auto const h{head_.load(std::memory_order_relaxed)};
+        auto& slot{slots_[h & (Capacity - 1)]};
+        slot[0].store(w0, std::memory_order_release);
+        slot[1].store(w1, std::memory_order_release);
+        slot[2].store(w2, std::memory_order_release);
+        head_.store(h + 1, std::memory_order_release);
+    }
+    // calls `out(w0, w1, w2)` for the events in the ring (oldest first);
+    // does not allocate, so it may be used from a signal handler (the
+    // slot of the oldest event in a full ring is skipped, as it may be
+    // the one being overwritten)
+    template<typename Out>
+    void drain(Out out) const {
+        auto const end{head_.load(std::memory_order_acquire)};
+        for (auto i{(end >= Capacity) ? end - Capacity + 1 : 0}; i < end; ++i) {
+            auto const& slot{slots_[i & (Capacity - 1)]};
+            std::uint64_t const w0{slot[0].load(std::memory_order_acquire)};
+            std::uint64_t const w1{slot[1].load(std::memory_order_acquire)};
+            std::uint64_t const w2{slot[2].load(std::memory_order_acquire)};
+            // (a slot being overwritten implies a head of at least i+Capacity)
+            if (head_.load(std::memory_order_relaxed) - i < Capacity)
+                out(w0, w1, w2);
+        }
+    }
+};
+
+// The rings of all threads (a ring is never freed, so that the events
+// of a thread that terminated can still be dumped). Only the first
+// `MaxThreads` threads are registered for dumping.
+
+constexpr int MaxThreads{64};
+std::atomic<Ring*> rings[MaxThreads]{};
+std::atomic<int> threads{};
+
+inline Ring& this_thread_ring() {
+    thread_local Ring* const ring{[]{
+        auto const r{new Ring{}};
+        auto const index{threads.fetch_add(1)};
+        if (index < MaxThreads)
+            rings[index].store(r, std::memory_order_release);
+        return r;
+    }()};
+    return *ring;
+}
+
+inline void record(char command, GameState from, GameState to,
+                   bool accepted, int blackTime, int whiteTime) {
+    this_thread_ring().record(timestamp(),
+                              static_cast<std::uint8_t>(command)
+                            | (static_cast<std::uint64_t>(from) << 8)
+                            | (static_cast<std::uint64_t>(to) << 16)
+                            | (static_cast<std::uint64_t>(accepted) << 24),
+                              (static_cast<std::uint64_t>(blackTime) << 32)
+                            | static_cast<std::uint32_t>(whiteTime));
+}
+
+// A dump starts with `DumpMagic`, followed by four words per event (the
+// three of the event and the number of the thread). Only system calls
+// safe in a signal handler are used.
+
+constexpr char DumpMagic[8]{'C','C','T','R','A','C','E','1'};
+
+long dump(int fd) {
+    if (::write(fd, DumpMagic, sizeof DumpMagic) != sizeof DumpMagic)
+        return -1;
+    long events{};
+    std::uint64_t buffer[256][4];
+    int filled{};
+    auto const flush = [&]{
+        auto const size{filled * sizeof buffer[0]};
+        if (::write(fd, buffer, size) == static_cast<ssize_t>(size))
+            events += filled;
+        filled = 0;
+    };
+    auto const count{std::min(threads.load(), MaxThreads)};
+    for (int t{}; t < count; ++t) {
+        auto const ring{rings[t].load(std::memory_order_acquire)};
+        if (!ring)
+            continue;
+        ring->drain([&](std::uint64_t w0, std::uint64_t w1, std::uint64_t w2) {
+            auto& e{buffer[filled]};
+            e[0] = w0; e[1] = w1; e[2] = w2; e[3] = t;
+            if (++filled == 256)
+                flush();
+        });
+    }
+    flush();
+    return events;
+}
+
+long dump(const char* path) {
+    int const fd{::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+    if (fd == -1)
+        return -1;
+    auto const events{dump(fd)};
+    ::close(fd);
+    return events;
+}
+
+// Dumps all rings into `path` when the program crashes (then the
+// signal is raised again to terminate the program as usual).
+
+char crashPath[256]{};
+
+void dump_on_crash(const char* path) {
+    std::strncpy(crashPath, path, sizeof crashPath - 1);
+    struct sigaction action{};
+    action.sa_handler = [](int signal) {
+        dump(crashPath);
+        std::raise(signal);
+    };
+    action.sa_flags = SA_RESETHAND;
+    for (auto const signal : {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT})
+        ::sigaction(signal, &action, nullptr);
+}
+
+} // namespace trace
+
+#define CHESS_CLOCK_TRACE_EVENT(...) trace::record(__VA_ARGS__)
+
+#else
+
+#define CHESS_CLOCK_TRACE_EVENT(...) ((void)0)
+
+#endif
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`). All
+// commands pass `process`, which records them for tracing (see above)
+// around the FSM proper in `process_`.
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+    bool process_(char command);
+public:
+    GameState state() const { return theGameState_; }
+    int blackTime() const { return blackPlayerClock_.get(); }
+    int whiteTime() const { return whitePlayerClock_.get(); }
+    bool process(char command) {
+        [[maybe_unused]] auto const from{theGameState_};
+        bool const accepted{process_(command)};
+        CHESS_CLOCK_TRACE_EVENT(command, from, theGameState_, accepted,
+                                blackTime(), whiteTime());
+        return accepted;
+    }
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process_(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+
+#include <cstdint>
+#include <fstream>
+
+// Shows the events of a dump as text (one line per event), returns
+// the number of events or -1 if `path` is not a dump. (Available also
+// when tracing is not compiled in.)
+
+long decode_trace(const char* path, std::ostream& os) {
+    std::ifstream in{path, std::ios::binary};
+    char magic[8];
+    if (!in.read(magic, sizeof magic)
+     || (std::string(magic, sizeof magic) != "CCTRACE1"))
+        return -1;
+    auto const show_time = [&os](int tenthsecs) {
+        auto const saved_fill{os.fill()};
+        os << std::setfill(' ') << std::setw(3) << tenthsecs / 600 << ':'
+           << std::setfill('0') << std::setw(2) << tenthsecs / 10 % 60 << '.'
+                                << std::setw(1) << tenthsecs % 10;
+        os.fill(saved_fill);
+    };
+    long events{};
+    std::uint64_t e[4];
+    while (in.read(reinterpret_cast<char*>(e), sizeof e)) {
+        auto const state = [&e](int shift) {
+            return to_string(static_cast<GameState>((e[1] >> shift) & 0xff));
+        };
+        os << "thread " << e[3] << " @" << e[0] << ": '"
+           << static_cast<char>(e[1] & 0xff) << "' "
+           << (((e[1] >> 24) & 1) ? "accepted" : "ignored ") << ' '
+           << state(8) << " -> " << state(16) << " | B:";
+        show_time(static_cast<std::int32_t>(e[2] >> 32));
+        os << " | W:";
+        show_time(static_cast<std::int32_t>(e[2] & 0xffffffff));
+        os << '\n';
+        ++events;
+    }
+    return events;
+}
+
+#ifdef CHESS_CLOCK_TRACE
+const char* tracePath{"Step_12p.trace"};
+#endif
+
+void runChessClock(std::ostream& clkout)
+{
+    ChessClock chessClock{};
+    char command;
+    while (std::cin.get(command)) {
+        command = std::tolower(static_cast<unsigned char>(command));
+        if (is_command(command)) {
+            std::cout << "===> " << command << std::endl;
+            switch (command) {
+                case '?':
+                    std::cout << "*** Chess Clock Commands ***\n"
+                                 "r - reset player clocks to initial time\n"
+                                 "s - start the game (white draws first)\n"
+                                 "p - pause the game\n"
+                                 "c - continue the game\n"
+                                 "x - switch to the other player\n"
+                                 "0..9 - advance the active player clock\n"
+#ifdef CHESS_CLOCK_TRACE
+                                 "t - dump the trace\n"
+#endif
+                                 "--- General Commends ---\n"
+                                 "? - show this list of commands\n"
+                                 ". - end the chess clock program\n";
+                    break;
+                case '.':
+                    std::cout << "Thanks for using the Chess-Clock" << std::endl;
+                    return;
+#ifdef CHESS_CLOCK_TRACE
+                case 't':
+                    std::cout << trace::dump(tracePath) << " events dumped to "
+                              << tracePath << std::endl;
+                    continue;
+#endif
+                default:
+                    if (!chessClock.process(command))
+                        continue;
+            }
+            chessClock.show(clkout);
+        }
+    }
+}
+
+
+#include <array>
+#include <chrono>
+#include <unistd.h> // read
+
+// The headless mode reads the commands in large blocks directly from
+// a file descriptor (bypassing `std::cin` and its per-character
+// overhead) and does not show anything for the individual commands.
+// Only the final state and some summary counters are reported.
+
+struct HeadlessSummary {
+    long long bytes{};
+    long long commands{};
+    long long ignored{};
+    long long whiteWins{};
+    long long blackWins{};
+    std::array<long long, 128> perCommand{};
+    void show(std::ostream&, std::chrono::duration<double>) const;
+};
+
+void HeadlessSummary::show(std::ostream& os,
+                           std::chrono::duration<double> elapsed) const {
+    os << "bytes read:         " << bytes << '\n'
+       << "commands processed: " << commands << '\n'
+       << "commands ignored:   " << ignored << '\n'
+       << "white player won:   " << whiteWins << '\n'
+       << "black player won:   " << blackWins << '\n'
+       << "commands by type:  ";
+    for (int c{}; c < static_cast<int>(perCommand.size()); ++c)
+        if (perCommand[c])
+            os << ' ' << static_cast<char>(c) << '=' << perCommand[c];
+    os << '\n'
+       << "elapsed seconds:    " << elapsed.count() << '\n'
+       << "commands/second:    " << commands / elapsed.count() << std::endl;
+}
+
+HeadlessSummary runHeadless(int fd, ChessClock& chessClock)
+{
+    HeadlessSummary summary{};
+    static char buffer[1<<16];
+    for (;;) {
+        auto const n{::read(fd, buffer, sizeof buffer)};
+        if (n <= 0)
+            return summary;
+        summary.bytes += n;
+        for (auto p{buffer}; p != buffer + n; ++p) {
+            char const command = std::tolower(static_cast<unsigned char>(*p));
+            if (!is_command(command))
+                continue;
+            ++summary.commands;
+            ++summary.perCommand[command];
+            if (command == '.')
+                return summary;
+            if (!chessClock.process(command)) {
+                ++summary.ignored;
+                continue;
+            }
+            switch (chessClock.state()) {
+            case GameState::WhiteWins: ++summary.whiteWins; break;
+            case GameState::BlackWins: ++summary.blackWins; break;
+            default: ;//avoid warning
+            }
+        }
+    }
+}
+
+#if 0
+
+#include <cassert>
+#include <sstream>
+#include <thread>
+
+void test_fsm_unchanged() {
+    ChessClock cc{};
+    assert(!cc.process('s'));       assert(cc.state() == GameState::Initial);
+    assert(cc.process('r'));        assert(cc.state() == GameState::Startable);
+    assert(cc.process('s'));        assert(cc.state() == GameState::WhiteDraw);
+    assert(cc.process('5'));        assert(cc.whiteTime() == InitialTime - 600);
+}
+
+#ifdef CHESS_CLOCK_TRACE
+
+void test_ring() {
+    trace::Ring ring{};
+    for (std::uint64_t i{}; i < trace::Ring::Capacity + 10; ++i)
+        ring.record(i, 2*i, 3*i);
+    std::uint64_t expected{11}, count{};
+    ring.drain([&](std::uint64_t w0, std::uint64_t w1, std::uint64_t w2) {
+        assert((w0 == expected) && (w1 == 2*w0) && (w2 == 3*w0));
+        ++expected;
+        ++count;
+    });
+    assert(count == trace::Ring::Capacity - 1);
+}
+
+void test_dump() {
+    std::thread other{[]{
+        ChessClock cc{};
+        cc.process('r');
+    }};
+    other.join();
+    ChessClock cc{};
+    cc.process('s');
+    cc.process('r');
+    cc.process('s');
+    cc.process('6');
+    char const path[]{"/tmp/Step_12p_test.trace"};
+    // (including the events recorded by `test_fsm_unchanged`)
+    assert(trace::dump(path) == 4 + 1 + 4);
+    std::ostringstream os{};
+    assert(decode_trace(path, os) == 4 + 1 + 4);
+    auto const text{os.str()};
+    assert(text.find(": 's' ignored  Initial -> Initial | B:  0:00.0 |")
+                != std::string::npos);
+    assert(text.find(": '6' accepted WhiteDraw -> WhiteDraw | B: 30:00.0"
+                     " | W: 25:00.0") != std::string::npos);
+    assert(text.find("thread 1 @") != std::string::npos);
+    ::unlink(path);
+}
+
+void test_cost() {
+    ChessClock cc{};
+    cc.process('r');
+    cc.process('s');
+    constexpr int Events{10'000'000};
+    auto const start{std::chrono::steady_clock::now()};
+    for (int i{}; i < Events; ++i)
+        trace::record('0', GameState::WhiteDraw, GameState::WhiteDraw,
+                      true, i, i);
+    std::chrono::duration<double, std::nano> const elapsed{
+                                    std::chrono::steady_clock::now() - start};
+    std::cout << "trace::record: " << elapsed.count() / Events
+              << " ns/event" << std::endl;
+}
+
+#endif
+
+int main() {
+    test_fsm_unchanged();
+#ifdef CHESS_CLOCK_TRACE
+    test_ring();
+    test_dump();
+    test_cost();
+#endif
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <fcntl.h>  // open
+#include <string>
+
+// Usage: Step_12p [/dev/ttyX]              (interactive)
+//        Step_12p --headless [command-file] (batch, default is stdin)
+//        Step_12p --decode trace-file       (show a trace dump)
+//
+// (compile with -DCHESS_CLOCK_TRACE to record the trace, which is
+// dumped by the `t` command and when the program crashes)
+
+int main(int argc, char *argv[])
+{
+    if ((argc == 3) && (std::string{argv[1]} == "--decode")) {
+        if (decode_trace(argv[2], std::cout) < 0) {
+            std::cerr << "not a trace dump: " << argv[2] << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+#ifdef CHESS_CLOCK_TRACE
+    trace::dump_on_crash(tracePath);
+#endif
+    if ((argc >= 2) && (std::string{argv[1]} == "--headless")) {
+        int fd{0};
+        if ((argc == 3)
+         && (fd = ::open(argv[2], O_RDONLY)) == -1) {
+            std::cerr << "cannot open: " << argv[2] << std::endl;
+            return 1;
+        }
+        ChessClock chessClock{};
+        using std::chrono::steady_clock;
+        auto const start{steady_clock::now()};
+        auto const summary{runHeadless(fd, chessClock)};
+        auto const elapsed{steady_clock::now() - start};
+        std::cout << "final state:        "
+                  << to_string(chessClock.state()) << '\n';
+        chessClock.show(std::cout);
+        summary.show(std::cout, elapsed);
+        return 0;
+    }
+    std::ofstream clock_display{};
+    if ((argc == 2)
+     && std::string{argv[1]}.find("/dev/tty") == 0) {
+        clock_display.open(argv[1]);
+        if (clock_display) {
+            std::cout << "CLOCK DISPLAY: " << argv[1] << std::endl;
+            clock_display << "*** CHESS CLOCK DISPLAY ***\n";
+        }
+    }
+    runChessClock(clock_display.is_open() ? clock_display : std::cout);
+}
+
+#endif
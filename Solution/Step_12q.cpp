@@ -0,0 +1,390 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+// Call counting (compiled in only with `-DCHESS_CLOCK_COUNT_CALLS`):
+// the functions of the counter chain count how often they are called
+// on behalf of which `Clock`, so that the number of (virtual) calls a
+// single tick costs can be seen and the effect of an optimization be
+// verified. As explored in Step 5a the functions are told apart by
+// `__PRETTY_FUNCTION__`, which is looked up only once per function
+// (in the initialization of a function local static) and mapped to a
+// small number indexing the counters. The `Clock` on whose behalf a
+// counter function runs is the one whose member function was entered
+// last in the calling thread. Without the macro no counting code is
+// left at all.
+
+#ifdef CHESS_CLOCK_COUNT_CALLS
+
+#include <algorithm> // std::find
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace calls {
+
+constexpr int MaxFunctions{16};
+
+class Registry;
+
+// The counters of one `Clock` (updated by the thread running the clock
+// and readable at any time from any thread).
+
+class Counters {
+    friend class Registry;
+    std::string name_{};
+    std::atomic<long long> counts_[MaxFunctions]{};
+public:
+    Counters();
+    Counters(const Counters&)            =delete;
+    Counters& operator=(const Counters&) =delete;
+    ~Counters();
+    const std::string& name() const { return name_; }
+    void count(int function) {
+        auto& c{counts_[function]};
+        c.store(c.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+    }
+};
+
+class Registry {
+    mutable std::mutex mutex_{};
+    std::vector<const char*> functions_{};
+    std::vector<Counters*> counters_{};
+    int created_{};
+public:
+    static Registry& instance() {
+        static Registry registry{};
+        return registry;
+    }
+    int function(const char* pretty) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        for (int i{}; i < static_cast<int>(functions_.size()); ++i)
+            if (functions_[i] == pretty)
+                return i;
+        if (functions_.size() == MaxFunctions)
+            return MaxFunctions - 1; // (shared by all further functions)
+        functions_.push_back(pretty);
+        return functions_.size() - 1;
+    }
+    std::string add(Counters* counters) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        counters_.push_back(counters);
+        return "clock " + std::to_string(++created_);
+    }
+    void remove(Counters* counters) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        counters_.erase(std::find(counters_.begin(), counters_.end(),
+                                  counters));
+    }
+    // clock name -> function -> number of calls
+    std::map<std::string, std::map<std::string, long long>> snapshot() const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        std::map<std::string, std::map<std::string, long long>> result{};
+        for (auto const c : counters_) {
+            auto& functions{result[c->name_]};
+            for (int i{}; i < static_cast<int>(functions_.size()); ++i)
+                if (auto const n{c->counts_[i].load(std::memory_order_relaxed)})
+                    functions[functions_[i]] = n;
+        }
+        return result;
+    }
+};
+
+Counters::Counters() : name_{Registry::instance().add(this)} {/*empty*/}
+Counters::~Counters() { Registry::instance().remove(this); }
+
+inline thread_local Counters* current{};
+
+class Scope {
+    Counters* const saved_;
+public:
+    explicit Scope(Counters& counters) : saved_{current} {
+        current = &counters;
+    }
+    Scope(const Scope&)            =delete;
+    Scope& operator=(const Scope&) =delete;
+    ~Scope() { current = saved_; }
+};
+
+inline void count(int function) {
+    if (current)
+        current->count(function);
+}
+
+// Shows the number of calls per function and clock, divided by `per`
+// (eg. the number of ticks).
+
+void report(std::ostream& os, double per = 1.0) {
+    for (auto const& [clock, functions] : Registry::instance().snapshot()) {
+        os << clock << ":" << (functions.empty() ? " (no calls)\n" : "\n");
+        for (auto const& [function, n] : functions)
+            os << std::setw(14) << n / per << "  " << function << '\n';
+    }
+    os.flush();
+}
+
+} // namespace calls
+
+#define COUNT_CALL() \
+    do { \
+        static int const function_{ \
+            calls::Registry::instance().function(__PRETTY_FUNCTION__)}; \
+        calls::count(function_); \
+    } while (false)
+#define COUNT_CALLS_FOR(counters) \
+    calls::Scope const count_calls_for_{counters}
+
+#else
+
+#define COUNT_CALL() ((void)0)
+#define COUNT_CALLS_FOR(counters) ((void)0)
+
+#endif
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const {
+        COUNT_CALL();
+        return false;
+    }
+    virtual void chained_needs_step() { COUNT_CALL(); }
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     COUNT_CALL();
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    COUNT_CALL();
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        COUNT_CALL();
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        COUNT_CALL();
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+#ifdef CHESS_CLOCK_COUNT_CALLS
+    mutable calls::Counters calls_{};
+#endif
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    COUNT_CALLS_FOR(calls_);
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    COUNT_CALLS_FOR(calls_);
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        COUNT_CALLS_FOR(calls_);
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    COUNT_CALLS_FOR(calls_);
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    COUNT_CALLS_FOR(calls_);
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+// The clockwork of Step 12 advances the active player clock once per
+// tick, ie. it checks whether the clock still counts and steps it.
+
+bool tick(Clock& clk) {
+    if (!clk)
+        return false;
+    --clk;
+    return true;
+}
+
+#if 0
+
+#include <cassert>
+#include <sstream>
+
+void test_counts() {
+    Clock clk{};
+    clk.set(InitialTime);
+#ifdef CHESS_CLOCK_COUNT_CALLS
+    auto const before{calls::Registry::instance().snapshot()};
+    auto const name{before.begin()->first};
+#endif
+    // 10:00.0 -> 9:59.9 borrows through the whole chain
+    clk.set(6000);
+    assert(tick(clk));
+    assert(clk.get() == 5999);
+#ifdef CHESS_CLOCK_COUNT_CALLS
+    auto const after{calls::Registry::instance().snapshot()};
+    assert(after.size() == 1);
+    auto const& functions{after.at(name)};
+    auto const calls_of = [&functions](const char* what) {
+        long long n{};
+        for (auto const& [function, count] : functions)
+            if (function.find(what) != std::string::npos)
+                n += count;
+        return n;
+    };
+    // operator bool: is_counting (tenthsecs) -> chained_is_counting
+    //   -> is_counting (seconds) -> chained_is_counting -> is_counting
+    //   (minutes)
+    // operator--: step (tenthsecs) -> chained_is_counting (as above)
+    //   -> chained_needs_step -> step (seconds) -> chained_is_counting
+    //   -> is_counting (minutes) -> chained_needs_step -> step (minutes)
+    assert(calls_of("::is_counting() const") == 3 + 3);
+    assert(calls_of("::chained_is_counting() const") == 2 + 3);
+    assert(calls_of("::step()") == 3);
+    assert(calls_of("::chained_needs_step()") == 2);
+    std::ostringstream os{};
+    calls::report(os);
+    assert(os.str().find(name + ":\n") == 0);
+    {
+        Clock other{};
+        assert(calls::Registry::instance().snapshot().size() == 2);
+    }
+    assert(calls::Registry::instance().snapshot().size() == 1);
+#endif
+}
+
+int main() {
+    test_counts();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <chrono>
+
+// Runs a clock down from the initial time tick by tick (as in Step 12)
+// and another one in steps of one minute (with the bulk `-=` of Step
+// 12d) and shows the calls per tick for both.
+
+int main() {
+    Clock ticked{};
+    Clock bulk{};
+    ticked.set(InitialTime);
+    bulk.set(InitialTime);
+    using std::chrono::steady_clock;
+    auto const start{steady_clock::now()};
+    int ticks{};
+    while (tick(ticked))
+        ++ticks;
+    std::chrono::duration<double, std::nano> const elapsed{
+                                                steady_clock::now() - start};
+    while (bulk -= 600)
+        ;
+    std::cout << "ticked " << ticks << " times in "
+              << elapsed.count() / ticks << " ns/tick\n";
+#ifdef CHESS_CLOCK_COUNT_CALLS
+    std::cout << "calls per tick (clock 1 ticked, clock 2 in bulk):\n";
+    calls::report(std::cout, ticks);
+#else
+    std::cout << "(compile with -DCHESS_CLOCK_COUNT_CALLS to count calls)"
+              << std::endl;
+#endif
+}
+
+#endif
@@ -0,0 +1,774 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <thread>
+
+// Scoped timers: a `ScopedTimer` records the time from its creation to
+// its destruction as a (complete) event of the calling thread. Events
+// are collected per thread without any synchronization in chunks of
+// fixed size; only a full chunk is handed over (with a lock-free push)
+// to a writer thread, which appends the events to a file in the Chrome
+// trace event format (JSON, to be loaded in `chrome://tracing` or the
+// Perfetto UI). Timers are only recorded while a trace file is open,
+// otherwise they cost one (relaxed) load.
+
+namespace tracing {
+
+struct Event {
+    const char* name;       // (a string with static storage duration)
+    std::int64_t start;     // (steady clock, nanoseconds)
+    std::int64_t duration;
+};
+
+struct Chunk {
+    static constexpr int Capacity{4096};
+    Chunk* next{};
+    int thread{};
+    const char* threadName{};
+    int size{};
+    Event events[Capacity];
+};
+
+std::atomic<bool> enabled{false};
+std::atomic<Chunk*> submitted{}; // (pushed by all threads)
+std::atomic<int> threads{};
+
+inline std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void submit(Chunk* chunk) {
+    chunk->next = submitted.load(std::memory_order_relaxed);
+    while (!submitted.compare_exchange_weak(chunk->next, chunk,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed))
+        ;
+}
+
+class ThreadBuffer {
+    Chunk* chunk_{};
+    int const thread_{threads.fetch_add(1) + 1};
+    const char* name_{};
+public:
+    ThreadBuffer() =default;
+    ThreadBuffer(const ThreadBuffer&)            =delete;
+    ThreadBuffer& operator=(const ThreadBuffer&) =delete;
+    ~ThreadBuffer() { flush(); }
+    void name(const char* name) { name_ = name; }
+    void add(const Event& event) {
+        if (!chunk_) {
+            chunk_ = new Chunk{};
+            chunk_->thread = thread_;
+        }
+        chunk_->events[chunk_->size++] = event;
+        if (chunk_->size == Chunk::Capacity)
+            flush();
+    }
+    void flush() {
+        if (!chunk_)
+            return;
+        chunk_->threadName = name_;
+        submit(chunk_);
+        chunk_ = nullptr;
+    }
+};
+
+inline ThreadBuffer& this_thread_buffer() {
+    thread_local ThreadBuffer buffer{};
+    return buffer;
+}
+
+// (shown as the name of the thread in the trace)
+inline void name_this_thread(const char* name) {
+    this_thread_buffer().name(name);
+}
+
+class ScopedTimer {
+    const char* const name_;
+    std::int64_t const start_;
+public:
+    explicit ScopedTimer(const char* name)
+        : name_{enabled.load(std::memory_order_relaxed) ? name : nullptr}
+        , start_{name_ ? now() : 0}
+    {/*empty*/}
+    ScopedTimer(const ScopedTimer&)            =delete;
+    ScopedTimer& operator=(const ScopedTimer&) =delete;
+    ~ScopedTimer() {
+        if (name_)
+            this_thread_buffer().add({name_, start_, now() - start_});
+    }
+};
+
+// Opening the trace file enables the timers, closing it (in the
+// destructor) writes the events still buffered by the calling thread
+// and all chunks submitted so far. (So other threads recording events
+// should have ended before, their buffers are submitted at exit.)
+
+class ChromeTraceFile {
+    std::ofstream out_;
+    std::int64_t const origin_{now()};
+    std::atomic<bool> stopping_{};
+    std::thread writer_{};
+    bool first_{true};
+    std::set<int> named_{};
+    long long events_{};
+    void write_submitted();
+public:
+    explicit ChromeTraceFile(const char* path);
+    ChromeTraceFile(const ChromeTraceFile&)            =delete;
+    ChromeTraceFile& operator=(const ChromeTraceFile&) =delete;
+    ~ChromeTraceFile();
+    explicit operator bool() const { return out_.is_open(); }
+    long long events() const { return events_; }
+};
+
+ChromeTraceFile::ChromeTraceFile(const char* path) : out_{path} {
+    if (!out_)
+        return;
+    out_ << "{\"traceEvents\":[";
+    enabled = true;
+    writer_ = std::thread{[this]{
+        while (!stopping_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{500});
+            write_submitted();
+        }
+    }};
+}
+
+ChromeTraceFile::~ChromeTraceFile() {
+    if (!out_.is_open())
+        return;
+    enabled = false;
+    stopping_ = true;
+    writer_.join();
+    this_thread_buffer().flush();
+    write_submitted();
+    out_ << "\n]}\n";
+}
+
+void ChromeTraceFile::write_submitted() {
+    auto const separator = [this]() -> const char* {
+        if (!first_)
+            return ",\n";
+        first_ = false;
+        return "\n";
+    };
+    out_ << std::fixed << std::setprecision(3);
+    for (auto chunk{submitted.exchange(nullptr, std::memory_order_acquire)};
+         chunk; ) {
+        if (named_.insert(chunk->thread).second && chunk->threadName)
+            out_ << separator()
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                    "\"tid\":" << chunk->thread
+                 << ",\"args\":{\"name\":\"" << chunk->threadName << "\"}}";
+        for (int i{}; i < chunk->size; ++i) {
+            auto const& e{chunk->events[i]};
+            out_ << separator()
+                 << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"ts\":"
+                 << (e.start - origin_) / 1e3 << ",\"dur\":"
+                 << e.duration / 1e3 << ",\"pid\":1,\"tid\":"
+                 << chunk->thread << '}';
+        }
+        events_ += chunk->size;
+        auto const next{chunk->next};
+        delete chunk;
+        chunk = next;
+    }
+    out_.flush();
+}
+
+} // namespace tracing
+
+#define TRACE_SCOPE(name) tracing::ScopedTimer const scoped_timer_{name}
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    TRACE_SCOPE("showGameState");
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <thread>
+
+// The clockwork of Step 12 was hard-wired to real time. To run it
+// faster than real time (eg. in regression tests of complete games)
+// the time source is now injected through an interface, similar to
+// `I_DownCounting` above. Whatever time source is used, the clockwork
+// and its subscriber run exactly the same code.
+
+class I_TimeSource {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    virtual time_point now() const =0;
+    virtual void sleep_until(time_point) =0;
+};
+
+class SteadyTimeSource : public I_TimeSource {
+public:
+    time_point now() const override {
+        return std::chrono::steady_clock::now();
+    }
+    void sleep_until(time_point t) override {
+        std::this_thread::sleep_until(t);
+    }
+};
+
+// Virtual time only advances when the clockwork sleeps, so that runs
+// are fully deterministic. With a `speedup` of zero a sleep returns at
+// once, otherwise virtual time is mapped to real time divided by
+// `speedup` (eg. 10'000 runs a 30 minute game in 0.18 seconds). As the
+// mapping is absolute, oversleeping in one tick is caught up in the
+// next ones.
+
+class SimulatedTimeSource : public I_TimeSource {
+    std::atomic<time_point::rep> now_{}; // (read by other threads)
+    const double speedup_{};
+    const time_point real_start_{std::chrono::steady_clock::now()};
+public:
+    explicit SimulatedTimeSource(double speedup = 0.0)
+        : speedup_{speedup}
+    {/*empty*/}
+    time_point now() const override {
+        return time_point{time_point::duration{now_.load()}};
+    }
+    void sleep_until(time_point t) override {
+        if (t <= now())
+            return;
+        if (speedup_ > 0.0)
+            std::this_thread::sleep_until(real_start_
+                + std::chrono::duration_cast<time_point::duration>(
+                        t.time_since_epoch() / speedup_));
+        now_.store(t.time_since_epoch().count());
+    }
+};
+
+I_TimeSource& steady_time_source() {
+    static SteadyTimeSource instance{};
+    return instance;
+}
+
+// Compared to Step 12 the clockwork now
+// - sleeps until an absolute deadline, so that the tick period does
+//   not drift by the time the subscriber takes,
+// - calls the subscriber after (not before) the first period passed,
+// - uses an atomic flag to be stopped from another thread.
+
+class ClockWork {
+    I_TimeSource& time_;
+    const std::chrono::nanoseconds period_;
+    std::atomic<bool> stopping_{};
+    std::function<void()> subscriber_{};
+    std::thread cw_thread_{};
+public:
+    explicit ClockWork(I_TimeSource& time_source = steady_time_source(),
+                       std::chrono::nanoseconds period
+                            = std::chrono::milliseconds{100})
+        : time_{time_source}, period_{period}
+    {/*empty*/}
+    auto start() {
+        std::cout << "--- clockwork will be started" << std::endl;
+        cw_thread_ = std::thread{[this]{
+                tracing::name_this_thread("clockwork");
+                auto next_tick{time_.now()};
+                while (!stopping_) {
+                    next_tick += period_;
+                    time_.sleep_until(next_tick);
+                    TRACE_SCOPE("tick");
+                    if (subscriber_)
+                        subscriber_();
+                }
+            }
+        };
+        std::cout << "--- clockwork thread running" << std::endl;
+    }
+    auto stop() {
+        std::cout << "--- clockwork will be stopped" << std::endl;
+        stopping_ = true;
+        if (cw_thread_.joinable())
+            cw_thread_.join();
+        std::cout << "--- clockwork thread ended" << std::endl;
+        stopping_ = false;
+    }
+    void attach(std::function<void()> subscriber) {
+        subscriber_ = subscriber;
+        std::cout << "--- subscriber "
+                  << (subscriber_ ? "attached to"
+                                  : "detached from")
+                  << " clockwork" << std::endl;
+    }
+};
+
+#include <mutex>
+
+// The chess clock now runs in real time: the clockwork advances the
+// clock of the active player every tick while the commands are read
+// from `in` (both update and show the chess clock under a mutex).
+
+void runChessClock(std::istream& in, std::ostream& clkout, ClockWork& cw)
+{
+    ChessClock chessClock{};
+    std::mutex mutex{};
+    cw.attach([&]{
+        TRACE_SCOPE("subscriber");
+        std::lock_guard<std::mutex> lock{mutex};
+        if (chessClock.process('1'))
+            chessClock.show(clkout);
+    });
+    cw.start();
+    char command;
+    while (in.get(command)) {
+        command = std::tolower(static_cast<unsigned char>(command));
+        if (is_command(command)) {
+            TRACE_SCOPE("command");
+            std::cout << "===> " << command << std::endl;
+            switch (command) {
+                case '?':
+                    std::cout << "*** Chess Clock Commands ***\n"
+                                 "r - reset player clocks to initial time\n"
+                                 "s - start the game (white draws first)\n"
+                                 "p - pause the game\n"
+                                 "c - continue the game\n"
+                                 "x - switch to the other player\n"
+                                 "0..9 - advance the active player clock\n"
+                                 "--- General Commends ---\n"
+                                 "? - show this list of commands\n"
+                                 ". - end the chess clock program\n";
+                    break;
+                case '.':
+                    std::cout << "Thanks for using the Chess-Clock" << std::endl;
+                    cw.stop();
+                    return;
+                default:
+                    std::lock_guard<std::mutex> lock{mutex};
+                    if (chessClock.process(command))
+                        chessClock.show(clkout);
+            }
+        }
+    }
+    cw.stop();
+}
+
+#if 0
+
+#include <cassert>
+#include <cstdio>   // std::remove
+#include <sstream>
+
+std::string read_file(const char* path) {
+    std::ifstream in{path};
+    std::ostringstream content{};
+    content << in.rdbuf();
+    return content.str();
+}
+
+long count(const std::string& text, const std::string& what) {
+    long n{};
+    for (auto at{text.find(what)}; at != std::string::npos;
+              at = text.find(what, at + what.size()))
+        ++n;
+    return n;
+}
+
+void test_scoped_timers() {
+    char const path[]{"/tmp/Step_12r_test.json"};
+    {
+        TRACE_SCOPE("not recorded"); // (no trace file open)
+    }
+    {
+        tracing::ChromeTraceFile trace{path};
+        assert(trace);
+        std::thread other{[]{
+            tracing::name_this_thread("other");
+            for (int i{}; i < tracing::Chunk::Capacity + 10; ++i) {
+                TRACE_SCOPE("busy");
+            }
+        }};
+        other.join();
+        TRACE_SCOPE("main");
+    }
+    auto const json{read_file(path)};
+    assert(json.compare(0, 16, "{\"traceEvents\":[") == 0);
+    assert(json.compare(json.size() - 4, 4, "\n]}\n") == 0);
+    assert(count(json, "\"name\":\"busy\",\"ph\":\"X\"")
+                == tracing::Chunk::Capacity + 10);
+    assert(count(json, "\"name\":\"main\",\"ph\":\"X\"") == 1);
+    assert(count(json, "\"args\":{\"name\":\"other\"}") == 1);
+    assert(count(json, "not recorded") == 0);
+    std::remove(path);
+}
+
+// Input which pauses (for `delay`) before it delivers a `.`.
+
+class DelayedInput : public std::streambuf {
+    std::string text_;
+    std::chrono::milliseconds delay_;
+    std::size_t at_{};
+    char current_{};
+    int_type underflow() override {
+        if (at_ == text_.size())
+            return traits_type::eof();
+        current_ = text_[at_++];
+        if (current_ == '.')
+            std::this_thread::sleep_for(delay_);
+        setg(&current_, &current_, &current_ + 1);
+        return traits_type::to_int_type(current_);
+    }
+public:
+    DelayedInput(std::string text, std::chrono::milliseconds delay)
+        : text_{text}, delay_{delay}
+    {/*empty*/}
+};
+
+void test_chess_clock_regions() {
+    char const path[]{"/tmp/Step_12r_test.json"};
+    {
+        tracing::ChromeTraceFile trace{path};
+        SimulatedTimeSource fast{100.0}; // (1ms per tick)
+        ClockWork cw{fast};
+        DelayedInput input{"rs.", std::chrono::milliseconds{50}};
+        std::istream commands{&input};
+        std::ostringstream display{};
+        runChessClock(commands, display, cw);
+        assert(display.str().find("W: 29:59.") != std::string::npos);
+    }
+    auto const json{read_file(path)};
+    assert(count(json, "\"name\":\"command\"") == 3);
+    assert(count(json, "\"name\":\"tick\"") > 10);
+    assert(count(json, "\"name\":\"subscriber\"")
+                == count(json, "\"name\":\"tick\""));
+    assert(count(json, "\"name\":\"showGameState\"") > 10);
+    assert(count(json, "\"args\":{\"name\":\"clockwork\"}") == 1);
+    std::remove(path);
+}
+
+int main() {
+    test_scoped_timers();
+    test_chess_clock_regions();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <memory>
+#include <string>
+
+// Usage: Step_12r [--trace file.json] [/dev/ttyX]
+
+int main(int argc, char *argv[])
+{
+    int arg{1};
+    std::unique_ptr<tracing::ChromeTraceFile> trace{};
+    if ((argc >= 3) && (std::string{argv[1]} == "--trace")) {
+        trace = std::make_unique<tracing::ChromeTraceFile>(argv[2]);
+        if (!*trace) {
+            std::cerr << "cannot open: " << argv[2] << std::endl;
+            return 1;
+        }
+        tracing::name_this_thread("main");
+        arg += 2;
+    }
+    std::ofstream clock_display{};
+    if ((argc == arg + 1)
+     && std::string{argv[arg]}.find("/dev/tty") == 0) {
+        clock_display.open(argv[arg]);
+        if (clock_display) {
+            std::cout << "CLOCK DISPLAY: " << argv[arg] << std::endl;
+            clock_display << "*** CHESS CLOCK DISPLAY ***\n";
+        }
+    }
+    ClockWork cw{};
+    runChessClock(std::cin,
+                  clock_display.is_open() ? clock_display : std::cout, cw);
+    if (trace) {
+        trace.reset();
+        std::cout << "*** trace written to " << argv[2] << std::endl;
+    }
+}
+
+#endif
@@ -0,0 +1,455 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+bool Clock::operator-=(int steps) {
+    while (steps > 0) {
+        if (!this->operator bool())
+            return false;
+        --*this;
+        --steps;
+    }
+    return true;
+}
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <thread>
+
+// The clockwork of Step 12 was hard-wired to real time. To run it
+// faster than real time (eg. in regression tests of complete games)
+// the time source is now injected through an interface, similar to
+// `I_DownCounting` above. Whatever time source is used, the clockwork
+// and its subscriber run exactly the same code.
+
+class I_TimeSource {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    virtual time_point now() const =0;
+    virtual void sleep_until(time_point) =0;
+};
+
+class SteadyTimeSource : public I_TimeSource {
+public:
+    time_point now() const override {
+        return std::chrono::steady_clock::now();
+    }
+    void sleep_until(time_point t) override {
+        std::this_thread::sleep_until(t);
+    }
+};
+
+// Virtual time only advances when the clockwork sleeps, so that runs
+// are fully deterministic. With a `speedup` of zero a sleep returns at
+// once, otherwise virtual time is mapped to real time divided by
+// `speedup` (eg. 10'000 runs a 30 minute game in 0.18 seconds). As the
+// mapping is absolute, oversleeping in one tick is caught up in the
+// next ones.
+
+class SimulatedTimeSource : public I_TimeSource {
+    std::atomic<time_point::rep> now_{}; // (read by other threads)
+    const double speedup_{};
+    const time_point real_start_{std::chrono::steady_clock::now()};
+public:
+    explicit SimulatedTimeSource(double speedup = 0.0)
+        : speedup_{speedup}
+    {/*empty*/}
+    time_point now() const override {
+        return time_point{time_point::duration{now_.load()}};
+    }
+    void sleep_until(time_point t) override {
+        if (t <= now())
+            return;
+        if (speedup_ > 0.0)
+            std::this_thread::sleep_until(real_start_
+                + std::chrono::duration_cast<time_point::duration>(
+                        t.time_since_epoch() / speedup_));
+        now_.store(t.time_since_epoch().count());
+    }
+};
+
+I_TimeSource& steady_time_source() {
+    static SteadyTimeSource instance{};
+    return instance;
+}
+
+#include <algorithm>
+#include <cstdint>
+
+// A histogram of durations in fixed memory (as in HdrHistogram): below
+// 2*SubBuckets nanoseconds every value has a bucket of its own, above
+// each power of two is divided into `SubBuckets` buckets of equal
+// width, so that the value of a bucket is off by less than 1% (1/128)
+// from any value counted in it, from nanoseconds up to minutes. It is
+// written by one thread and may be read by any other at any time
+// (with relaxed atomics, ie. a report taken while recording may be
+// a few counts behind).
+
+class LatencyHistogram {
+public:
+    static constexpr int SubBucketBits{7};
+    static constexpr std::int64_t SubBuckets{1 << SubBucketBits};
+    static constexpr int MaxShift{40 - SubBucketBits}; // (2^40ns = 18min)
+    static constexpr int Buckets{(MaxShift + 2) * SubBuckets};
+private:
+    std::atomic<std::uint64_t> counts_[Buckets]{};
+    std::atomic<std::uint64_t> total_{};
+    std::atomic<std::int64_t> max_{};
+    static int index(std::int64_t value);
+    static std::int64_t highest(int index);
+    template<typename T> static void add(std::atomic<T>& a, T n) {
+        a.store(a.load(std::memory_order_relaxed) + n,
+                std::memory_order_relaxed);
+    }
+public:
+    void record(std::chrono::nanoseconds);
+    std::uint64_t count() const { return total_.load(); }
+    std::chrono::nanoseconds max() const {
+        return std::chrono::nanoseconds{max_.load()};
+    }
+    // the smallest value not exceeded by `fraction` of the values
+    // (rounded up to the largest value of its bucket)
+    std::chrono::nanoseconds percentile(double fraction) const;
+    void show(std::ostream&) const;
+};
+
+int LatencyHistogram::index(std::int64_t value) {
+    if (value < 2*SubBuckets)
+        return static_cast<int>(std::max<std::int64_t>(value, 0));
+    int const magnitude{63 - __builtin_clzll(value)};
+    int const shift{std::min(magnitude - SubBucketBits, MaxShift)};
+    auto const sub{std::min(value >> shift, 2*SubBuckets - 1)};
+    return static_cast<int>(shift * SubBuckets + sub);
+}
+
+std::int64_t LatencyHistogram::highest(int index) {
+    if (index < 2*SubBuckets)
+        return index;
+    int const shift{index / static_cast<int>(SubBuckets) - 1};
+    auto const sub{index - shift * SubBuckets};
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+    auto const value{duration.count()};
+    add<std::uint64_t>(counts_[index(value)], 1);
+    add<std::uint64_t>(total_, 1);
+    if (value > max_.load(std::memory_order_relaxed))
+        max_.store(value, std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double fraction) const {
+    auto const total{total_.load(std::memory_order_relaxed)};
+    if (total == 0)
+        return {};
+    auto const wanted{std::max<std::uint64_t>(1,
+                        static_cast<std::uint64_t>(fraction * total + 0.5))};
+    std::uint64_t seen{};
+    for (int i{}; i < Buckets; ++i)
+        if ((seen += counts_[i].load(std::memory_order_relaxed)) >= wanted)
+            return (i == Buckets - 1) // (also any value beyond the range)
+                    ? max()
+                    : std::chrono::nanoseconds{
+                        std::min(highest(i), max().count())};
+    return max();
+}
+
+void LatencyHistogram::show(std::ostream& os) const {
+    auto const ms = [](std::chrono::nanoseconds d) {
+        return std::chrono::duration<double, std::milli>{d}.count();
+    };
+    os << "n=" << count()
+       << " p50=" << ms(percentile(0.5))
+       << " p99=" << ms(percentile(0.99))
+       << " p99.9=" << ms(percentile(0.999))
+       << " max=" << ms(max()) << " (ms)";
+}
+
+// Compared to Step 12c the clockwork measures
+// - the actual interval between consecutive ticks (ie. how far the
+//   period the players see deviates from the nominal one) and
+// - the time the subscriber takes per tick
+// in histograms which can be shown at any time (see `report`) and are
+// shown when the clockwork is stopped.
+
+class ClockWork {
+    I_TimeSource& time_;
+    const std::chrono::nanoseconds period_;
+    std::atomic<bool> stopping_{};
+    std::function<void()> subscriber_{};
+    std::thread cw_thread_{};
+    LatencyHistogram intervals_{};
+    LatencyHistogram subscriberTimes_{};
+public:
+    explicit ClockWork(I_TimeSource& time_source = steady_time_source(),
+                       std::chrono::nanoseconds period
+                            = std::chrono::milliseconds{100})
+        : time_{time_source}, period_{period}
+    {/*empty*/}
+    auto start() {
+        std::cout << "--- clockwork will be started" << std::endl;
+        cw_thread_ = std::thread{[this]{
+                auto next_tick{time_.now()};
+                auto last_tick{next_tick};
+                while (!stopping_) {
+                    next_tick += period_;
+                    time_.sleep_until(next_tick);
+                    auto const ticked{time_.now()};
+                    intervals_.record(ticked - last_tick);
+                    last_tick = ticked;
+                    if (subscriber_) {
+                        subscriber_();
+                        subscriberTimes_.record(time_.now() - ticked);
+                    }
+                }
+            }
+        };
+        std::cout << "--- clockwork thread running" << std::endl;
+    }
+    auto stop() {
+        std::cout << "--- clockwork will be stopped" << std::endl;
+        stopping_ = true;
+        if (cw_thread_.joinable())
+            cw_thread_.join();
+        std::cout << "--- clockwork thread ended" << std::endl;
+        report(std::cout);
+        stopping_ = false;
+    }
+    void attach(std::function<void()> subscriber) {
+        subscriber_ = subscriber;
+        std::cout << "--- subscriber "
+                  << (subscriber_ ? "attached to"
+                                  : "detached from")
+                  << " clockwork" << std::endl;
+    }
+    const LatencyHistogram& intervals() const { return intervals_; }
+    const LatencyHistogram& subscriberTimes() const {
+        return subscriberTimes_;
+    }
+    void report(std::ostream& os) const {
+        os << "--- tick interval:   ";
+        intervals_.show(os);
+        os << "\n--- subscriber time: ";
+        subscriberTimes_.show(os);
+        os << std::endl;
+    }
+};
+
+#if 0
+
+#include <cassert>
+
+void test_histogram() {
+    LatencyHistogram h{};
+    assert(h.percentile(0.5).count() == 0);
+    for (int i{1}; i <= 1000; ++i)
+        h.record(std::chrono::microseconds{i});
+    assert(h.count() == 1000);
+    assert(h.max() == std::chrono::microseconds{1000});
+    auto const near = [](std::chrono::nanoseconds actual,
+                         std::chrono::microseconds expected) {
+        auto const e{std::chrono::nanoseconds{expected}.count()};
+        return (actual.count() >= e) && (actual.count() <= e + e / 128);
+    };
+    assert(near(h.percentile(0.5), std::chrono::microseconds{500}));
+    assert(near(h.percentile(0.99), std::chrono::microseconds{990}));
+    assert(near(h.percentile(0.999), std::chrono::microseconds{999}));
+    assert(h.percentile(1.0) == h.max());
+    // small values are exact, huge ones end in the last bucket
+    LatencyHistogram small{};
+    small.record(std::chrono::nanoseconds{3});
+    small.record(std::chrono::nanoseconds{255});
+    assert(small.percentile(0.5).count() == 3);
+    assert(small.percentile(1.0).count() == 255);
+    small.record(std::chrono::hours{1});
+    assert(small.max() == std::chrono::hours{1});
+    assert(small.percentile(1.0) == std::chrono::hours{1});
+}
+
+void test_simulated_intervals() {
+    SimulatedTimeSource instant{};
+    ClockWork cw{instant};
+    std::promise<void> done{};
+    int ticks{};
+    cw.attach([&]{
+        if (++ticks == 1000)
+            done.set_value();
+    });
+    cw.start();
+    done.get_future().wait();
+    cw.stop();
+    // (virtual time only advances while the clockwork sleeps)
+    assert(cw.intervals().count() >= 1000);
+    assert(cw.intervals().percentile(0.5) == std::chrono::milliseconds{100});
+    assert(cw.intervals().max() == std::chrono::milliseconds{100});
+    assert(cw.subscriberTimes().max().count() == 0);
+}
+
+int main() {
+    test_histogram();
+    test_simulated_intervals();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <string>
+#include <vector>
+
+// Usage: Step_12s [seconds [busy-threads [subscriber-microseconds]]]
+//
+// Runs the clockwork in real time with a subscriber taking the given
+// time, while the given number of threads keep the CPUs busy, and
+// shows the histograms every second.
+
+int main(int argc, char* argv[]) {
+    int const seconds{(argc > 1) ? std::stoi(argv[1]) : 10};
+    int const busy{(argc > 2) ? std::stoi(argv[2]) : 0};
+    std::chrono::microseconds const work{(argc > 3) ? std::stoi(argv[3])
+                                                    : 100};
+    std::atomic<bool> stopping{false};
+    std::vector<std::thread> load{};
+    for (int i{}; i < busy; ++i)
+        load.emplace_back([&stopping]{
+            while (!stopping)
+                ; // (the atomic load is not optimized away)
+        });
+    ClockWork cw{};
+    Clock playerClock{};
+    playerClock.set(InitialTime);
+    cw.attach([&]{
+        --playerClock;
+        auto const until{std::chrono::steady_clock::now() + work};
+        while (std::chrono::steady_clock::now() < until)
+            ;
+    });
+    cw.start();
+    for (int s{}; s < seconds; ++s) {
+        std::this_thread::sleep_for(std::chrono::seconds{1});
+        cw.report(std::cout);
+    }
+    cw.stop();
+    stopping = true;
+    for (auto& t : load)
+        t.join();
+}
+
+#endif
@@ -0,0 +1,834 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+bool is_command(char command) {
+    return std::islower(command)
+        || std::isdigit(command)
+        || (command == '?')
+        || (command == '.');
+}
+
+
+#include <algorithm> // std::find
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>   // std::rename
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Metrics of the running chess clock, counted per thread: each thread
+// counts in a block of counters of its own (on cache lines of its own)
+// with plain (relaxed) loads and stores, ie. without atomic read-modify-
+// write instructions and without sharing cache lines with any other
+// thread. Only a scrape (eg. every few seconds) sums up the blocks of
+// all threads, plus the totals of the threads already ended. The
+// metrics are written in the Prometheus text exposition format.
+
+namespace metrics {
+
+constexpr int Commands{128};
+constexpr int States{8};
+
+template<typename Count>
+struct alignas(64) BasicCounters {
+    Count ticks{};
+    Count ticksMissed{};        // (delivered a period or more too late)
+    Count flagFalls{};
+    Count renderBytes{};
+    Count commands[Commands][2]{}; // ([command][accepted])
+    Count transitions[States]{};   // ([new state])
+};
+
+using Counters = BasicCounters<std::atomic<std::uint64_t>>;
+using Totals = BasicCounters<std::uint64_t>;
+
+void merge(Totals& into, const Counters& from) {
+    auto const add = [](std::uint64_t& total,
+                        const std::atomic<std::uint64_t>& count) {
+        total += count.load(std::memory_order_relaxed);
+    };
+    add(into.ticks, from.ticks);
+    add(into.ticksMissed, from.ticksMissed);
+    add(into.flagFalls, from.flagFalls);
+    add(into.renderBytes, from.renderBytes);
+    for (int c{}; c < Commands; ++c) {
+        add(into.commands[c][0], from.commands[c][0]);
+        add(into.commands[c][1], from.commands[c][1]);
+    }
+    for (int s{}; s < States; ++s)
+        add(into.transitions[s], from.transitions[s]);
+}
+
+class Registry {
+    mutable std::mutex mutex_{};
+    std::vector<const Counters*> live_{};
+    Totals ended_{};
+public:
+    static Registry& instance() {
+        static Registry registry{};
+        return registry;
+    }
+    void add(const Counters* counters) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        live_.push_back(counters);
+    }
+    void remove(const Counters* counters) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        merge(ended_, *counters);
+        live_.erase(std::find(live_.begin(), live_.end(), counters));
+    }
+    Totals scrape() const {
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto result{ended_};
+        for (auto const counters : live_)
+            merge(result, *counters);
+        return result;
+    }
+};
+
+class ThreadCounters {
+    Counters counters_{};
+public:
+    ThreadCounters() { Registry::instance().add(&counters_); }
+    ThreadCounters(const ThreadCounters&)            =delete;
+    ThreadCounters& operator=(const ThreadCounters&) =delete;
+    ~ThreadCounters() { Registry::instance().remove(&counters_); }
+    Counters& get() { return counters_; }
+};
+
+// (the counters of the calling thread)
+inline Counters& local() {
+    thread_local ThreadCounters counters{};
+    return counters.get();
+}
+
+// (may only be used for a counter of the calling thread)
+inline void add(std::atomic<std::uint64_t>& count, std::uint64_t n = 1) {
+    count.store(count.load(std::memory_order_relaxed) + n,
+                std::memory_order_relaxed);
+}
+
+void write(std::ostream& os, const Totals& totals) {
+    auto const counter = [&os](const char* name, const char* help) {
+        os << "# HELP " << name << ' ' << help << '\n'
+           << "# TYPE " << name << " counter\n";
+    };
+    counter("chessclock_ticks_total", "Clock ticks delivered.");
+    os << "chessclock_ticks_total " << totals.ticks << '\n';
+    counter("chessclock_ticks_missed_total",
+            "Clock ticks delivered a period or more after their deadline.");
+    os << "chessclock_ticks_missed_total " << totals.ticksMissed << '\n';
+    counter("chessclock_commands_total", "Commands processed by type.");
+    for (int c{}; c < Commands; ++c)
+        for (int accepted{}; accepted < 2; ++accepted)
+            if (auto const n{totals.commands[c][accepted]})
+                os << "chessclock_commands_total{command=\""
+                   << static_cast<char>(c) << "\",result=\""
+                   << (accepted ? "accepted" : "ignored") << "\"} "
+                   << n << '\n';
+    counter("chessclock_state_transitions_total",
+            "State transitions by new state.");
+    for (int s{}; s < States; ++s)
+        os << "chessclock_state_transitions_total{state=\""
+           << to_string(static_cast<GameState>(s)) << "\"} "
+           << totals.transitions[s] << '\n';
+    counter("chessclock_flag_falls_total",
+            "Games ended by a player clock running out.");
+    os << "chessclock_flag_falls_total " << totals.flagFalls << '\n';
+    counter("chessclock_render_bytes_total", "Bytes written to the display.");
+    os << "chessclock_render_bytes_total " << totals.renderBytes << '\n';
+}
+
+// Scrapes the counters every `interval` and writes them to `path` (via
+// a temporary file renamed to `path`, so that a reader never sees a
+// partially written file, eg. the textfile collector of the Prometheus
+// node exporter).
+
+class MetricsFile {
+    std::string const path_;
+    std::chrono::milliseconds const interval_;
+    std::mutex mutex_{};
+    std::condition_variable wakeup_{};
+    bool stopping_{};
+    mutable std::mutex writing_{};  // (`write_now` from any thread)
+    std::thread writer_{};
+public:
+    MetricsFile(std::string path, std::chrono::milliseconds interval)
+        : path_{path}, interval_{interval}
+    {
+        writer_ = std::thread{[this]{
+            std::unique_lock<std::mutex> lock{mutex_};
+            while (!wakeup_.wait_for(lock, interval_,
+                                     [this]{ return stopping_; }))
+                write_now();
+        }};
+    }
+    MetricsFile(const MetricsFile&)            =delete;
+    MetricsFile& operator=(const MetricsFile&) =delete;
+    ~MetricsFile() {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stopping_ = true;
+        }
+        wakeup_.notify_one();
+        writer_.join();
+        write_now();
+    }
+    bool write_now() const {
+        std::lock_guard<std::mutex> lock{writing_};
+        auto const temporary{path_ + ".tmp"};
+        {
+            std::ofstream out{temporary};
+            write(out, Registry::instance().scrape());
+            if (!out)
+                return false;
+        }
+        return std::rename(temporary.c_str(), path_.c_str()) == 0;
+    }
+};
+
+} // namespace metrics
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <thread>
+
+// The clockwork of Step 12 was hard-wired to real time. To run it
+// faster than real time (eg. in regression tests of complete games)
+// the time source is now injected through an interface, similar to
+// `I_DownCounting` above. Whatever time source is used, the clockwork
+// and its subscriber run exactly the same code.
+
+class I_TimeSource {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    virtual time_point now() const =0;
+    virtual void sleep_until(time_point) =0;
+};
+
+class SteadyTimeSource : public I_TimeSource {
+public:
+    time_point now() const override {
+        return std::chrono::steady_clock::now();
+    }
+    void sleep_until(time_point t) override {
+        std::this_thread::sleep_until(t);
+    }
+};
+
+// Virtual time only advances when the clockwork sleeps, so that runs
+// are fully deterministic. With a `speedup` of zero a sleep returns at
+// once, otherwise virtual time is mapped to real time divided by
+// `speedup` (eg. 10'000 runs a 30 minute game in 0.18 seconds). As the
+// mapping is absolute, oversleeping in one tick is caught up in the
+// next ones.
+
+class SimulatedTimeSource : public I_TimeSource {
+    std::atomic<time_point::rep> now_{}; // (read by other threads)
+    const double speedup_{};
+    const time_point real_start_{std::chrono::steady_clock::now()};
+public:
+    explicit SimulatedTimeSource(double speedup = 0.0)
+        : speedup_{speedup}
+    {/*empty*/}
+    time_point now() const override {
+        return time_point{time_point::duration{now_.load()}};
+    }
+    void sleep_until(time_point t) override {
+        if (t <= now())
+            return;
+        if (speedup_ > 0.0)
+            std::this_thread::sleep_until(real_start_
+                + std::chrono::duration_cast<time_point::duration>(
+                        t.time_since_epoch() / speedup_));
+        now_.store(t.time_since_epoch().count());
+    }
+};
+
+I_TimeSource& steady_time_source() {
+    static SteadyTimeSource instance{};
+    return instance;
+}
+
+// Compared to Step 12 the clockwork now
+// - sleeps until an absolute deadline, so that the tick period does
+//   not drift by the time the subscriber takes,
+// - calls the subscriber after (not before) the first period passed,
+// - uses an atomic flag to be stopped from another thread,
+// - counts the ticks (and those delivered late) in the metrics.
+
+class ClockWork {
+    I_TimeSource& time_;
+    const std::chrono::nanoseconds period_;
+    std::atomic<bool> stopping_{};
+    std::function<void()> subscriber_{};
+    std::thread cw_thread_{};
+public:
+    explicit ClockWork(I_TimeSource& time_source = steady_time_source(),
+                       std::chrono::nanoseconds period
+                            = std::chrono::milliseconds{100})
+        : time_{time_source}, period_{period}
+    {/*empty*/}
+    auto start() {
+        std::cout << "--- clockwork will be started" << std::endl;
+        cw_thread_ = std::thread{[this]{
+                auto next_tick{time_.now()};
+                while (!stopping_) {
+                    next_tick += period_;
+                    time_.sleep_until(next_tick);
+                    auto& counters{metrics::local()};
+                    metrics::add(counters.ticks);
+                    if (time_.now() - next_tick >= period_)
+                        metrics::add(counters.ticksMissed);
+                    if (subscriber_)
+                        subscriber_();
+                }
+            }
+        };
+        std::cout << "--- clockwork thread running" << std::endl;
+    }
+    auto stop() {
+        std::cout << "--- clockwork will be stopped" << std::endl;
+        stopping_ = true;
+        if (cw_thread_.joinable())
+            cw_thread_.join();
+        std::cout << "--- clockwork thread ended" << std::endl;
+        stopping_ = false;
+    }
+    void attach(std::function<void()> subscriber) {
+        subscriber_ = subscriber;
+        std::cout << "--- subscriber "
+                  << (subscriber_ ? "attached to"
+                                  : "detached from")
+                  << " clockwork" << std::endl;
+    }
+};
+
+#include <mutex>
+#include <sstream>
+
+// Counts the state transition (and flag fall) from `before` to the
+// current state of `chessClock`, if any.
+
+void count_transition(GameState before, const ChessClock& chessClock) {
+    auto const after{chessClock.state()};
+    if (after == before)
+        return;
+    auto& counters{metrics::local()};
+    metrics::add(counters.transitions[static_cast<int>(after)]);
+    if ((after == GameState::WhiteWins) || (after == GameState::BlackWins))
+        metrics::add(counters.flagFalls);
+}
+
+// Processes a command as `ChessClock::process` does and counts it in
+// the metrics (with the state transition or flag fall it caused).
+
+bool process(ChessClock& chessClock, char command) {
+    auto const before{chessClock.state()};
+    bool const accepted{chessClock.process(command)};
+    metrics::add(metrics::local().commands[static_cast<unsigned char>(command)
+                                           % metrics::Commands][accepted]);
+    count_transition(before, chessClock);
+    return accepted;
+}
+
+void show(const ChessClock& chessClock, std::ostream& clkout) {
+    std::ostringstream rendered{};
+    chessClock.show(rendered);
+    auto const text{rendered.str()};
+    clkout << text;
+    metrics::add(metrics::local().renderBytes, text.size());
+}
+
+// As in Step 12r the clockwork advances the clock of the active player
+// every tick while the commands are read from `in`. (The ticks are not
+// counted as commands, they are counted by the clockwork already, but
+// the flag falls they cause are.)
+
+void runChessClock(std::istream& in, std::ostream& clkout, ClockWork& cw)
+{
+    ChessClock chessClock{};
+    std::mutex mutex{};
+    cw.attach([&]{
+        std::lock_guard<std::mutex> lock{mutex};
+        auto const before{chessClock.state()};
+        if (chessClock.process('1')) {
+            count_transition(before, chessClock);
+            show(chessClock, clkout);
+        }
+    });
+    cw.start();
+    char command;
+    while (in.get(command)) {
+        command = std::tolower(static_cast<unsigned char>(command));
+        if (is_command(command)) {
+            std::cout << "===> " << command << std::endl;
+            switch (command) {
+                case '?':
+                    std::cout << "*** Chess Clock Commands ***\n"
+                                 "r - reset player clocks to initial time\n"
+                                 "s - start the game (white draws first)\n"
+                                 "p - pause the game\n"
+                                 "c - continue the game\n"
+                                 "x - switch to the other player\n"
+                                 "0..9 - advance the active player clock\n"
+                                 "--- General Commends ---\n"
+                                 "? - show this list of commands\n"
+                                 ". - end the chess clock program\n";
+                    break;
+                case '.':
+                    std::cout << "Thanks for using the Chess-Clock" << std::endl;
+                    cw.stop();
+                    return;
+                default:
+                    std::lock_guard<std::mutex> lock{mutex};
+                    if (process(chessClock, command))
+                        show(chessClock, clkout);
+            }
+        }
+    }
+    cw.stop();
+}
+
+#if 0
+
+#include <cassert>
+
+std::string exposition() {
+    std::ostringstream os{};
+    metrics::write(os, metrics::Registry::instance().scrape());
+    return os.str();
+}
+
+bool contains(const std::string& text, const std::string& line) {
+    return text.find(line + '\n') != std::string::npos;
+}
+
+void test_per_thread_counters() {
+    auto const commands_before{metrics::Registry::instance().scrape()
+                                    .commands['r'][1]};
+    std::vector<std::thread> threads{};
+    for (int t{}; t < 4; ++t)
+        threads.emplace_back([]{
+            for (int i{}; i < 1000; ++i) {
+                ChessClock cc{};
+                process(cc, 'r');
+            }
+        });
+    for (auto& t : threads)
+        t.join();
+    // (the counters of ended threads are kept)
+    assert(metrics::Registry::instance().scrape().commands['r'][1]
+                == commands_before + 4000);
+}
+
+void test_exposition() {
+    ChessClock cc{};
+    process(cc, 's');
+    process(cc, 'r');
+    process(cc, 's');
+    process(cc, '7');
+    std::ostringstream display{};
+    show(cc, display);
+    auto const text{exposition()};
+    assert(contains(text, "# TYPE chessclock_commands_total counter"));
+    assert(contains(text, "chessclock_commands_total{command=\"s\","
+                          "result=\"ignored\"} 1"));
+    assert(contains(text, "chessclock_commands_total{command=\"7\","
+                          "result=\"accepted\"} 1"));
+    assert(contains(text, "chessclock_state_transitions_total"
+                          "{state=\"BlackWins\"} 1"));
+    assert(contains(text, "chessclock_flag_falls_total 1"));
+    assert(contains(text, "chessclock_render_bytes_total "
+                          + std::to_string(display.str().size())));
+}
+
+void test_metrics_file() {
+    char const path[]{"/tmp/Step_12t_test.prom"};
+    {
+        metrics::MetricsFile file{path, std::chrono::milliseconds{10}};
+        SimulatedTimeSource fast{100.0}; // (1ms per tick)
+        ClockWork cw{fast};
+        cw.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        cw.stop();
+    }
+    std::ifstream in{path};
+    std::ostringstream content{};
+    content << in.rdbuf();
+    auto const ticks{metrics::Registry::instance().scrape().ticks};
+    assert(ticks > 10);
+    assert(contains(content.str(), "chessclock_ticks_total "
+                                   + std::to_string(ticks)));
+    std::remove(path);
+}
+
+// (delivers the commands, then waits a while before the end of the
+// input, so that the clockwork ticks the running game)
+
+class SlowInput : public std::streambuf {
+    std::string commands_;
+    bool waited_{};
+public:
+    explicit SlowInput(std::string commands)
+        : commands_{std::move(commands)}
+    {
+        setg(commands_.data(), commands_.data(),
+             commands_.data() + commands_.size());
+    }
+protected:
+    int_type underflow() override {
+        if (waited_)
+            return traits_type::eof();
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        waited_ = true;
+        commands_ = ".";
+        setg(commands_.data(), commands_.data(), commands_.data() + 1);
+        return traits_type::to_int_type(commands_[0]);
+    }
+};
+
+void test_ticks_not_counted_as_commands() {
+    auto const before{metrics::Registry::instance().scrape()};
+    SimulatedTimeSource fast{100.0}; // (1ms per tick)
+    ClockWork cw{fast};
+    SlowInput commands{"rs"};
+    std::istream in{&commands};
+    std::ostringstream display{};
+    runChessClock(in, display, cw);
+    auto const after{metrics::Registry::instance().scrape()};
+    assert(after.ticks > before.ticks + 10);
+    assert(after.commands['s'][1] == before.commands['s'][1] + 1);
+    assert(after.commands['1'][0] == before.commands['1'][0]);
+    assert(after.commands['1'][1] == before.commands['1'][1]);
+    assert(after.transitions[static_cast<int>(GameState::WhiteDraw)]
+                == before.transitions[static_cast<int>(GameState::WhiteDraw)]
+                    + 1);
+}
+
+int main() {
+    test_per_thread_counters();
+    test_exposition();
+    test_metrics_file();
+    test_ticks_not_counted_as_commands();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <memory>
+
+// Usage: Step_12t [--metrics file [seconds]] [/dev/ttyX]
+
+int main(int argc, char *argv[])
+{
+    int arg{1};
+    std::unique_ptr<metrics::MetricsFile> metricsFile{};
+    if ((argc >= arg + 2) && (std::string{argv[arg]} == "--metrics")) {
+        const char* const path{argv[arg + 1]};
+        int seconds{5};
+        arg += 2;
+        if ((argc > arg) && std::isdigit(argv[arg][0]))
+            seconds = std::stoi(argv[arg++]);
+        metricsFile = std::make_unique<metrics::MetricsFile>(path,
+                                        std::chrono::seconds{seconds});
+        if (!metricsFile->write_now()) {
+            std::cerr << "cannot write: " << path << std::endl;
+            return 1;
+        }
+    }
+    std::ofstream clock_display{};
+    if ((argc == arg + 1)
+     && std::string{argv[arg]}.find("/dev/tty") == 0) {
+        clock_display.open(argv[arg]);
+        if (clock_display) {
+            std::cout << "CLOCK DISPLAY: " << argv[arg] << std::endl;
+            clock_display << "*** CHESS CLOCK DISPLAY ***\n";
+        }
+    }
+    ClockWork cw{};
+    runChessClock(std::cin,
+                  clock_display.is_open() ? clock_display : std::cout, cw);
+}
+
+#endif
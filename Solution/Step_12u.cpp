@@ -0,0 +1,873 @@
+#include <chrono>   // std::chrono::steady_clock
+#include <cstdint>  // std::int64_t
+                    // std::uint64_t
+#include <cstdlib>  // std::atol
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <sstream>  // std::ostringstream
+#include <string>   // std::string
+                    // std::to_string
+
+// This sideline puts the different designs of class `Clock` as they
+// were developed from Step 1 to Step 12 (and in some of the sideline
+// steps) side by side and checks that they behave exactly the same
+// for every value a clock can take. To keep them apart each design
+// lives in its own namespace; the code is copied from the respective
+// step (leaving out the parts not required here), as in Step 12b.
+
+constexpr int MaxTime{1000*60*10 - 1}; // 999:59.9
+
+namespace plain_int { // Step 01 to Step 07
+
+class Clock {
+private:
+    int tenthSeconds_{0};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    auto set(int ts) {
+        tenthSeconds_ = ts;
+    }
+    auto get() const {
+        return tenthSeconds_;
+    }
+    explicit operator bool() const {
+        return (tenthSeconds_ > 0);
+    }
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+Clock& Clock::operator--() {
+    if (tenthSeconds_ > 0)
+        --tenthSeconds_;
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto ts = tenthSeconds_;
+    const auto t{ts % 10}; ts /= 10;
+    const auto s{ts % 60}; ts /= 60;
+    std::string result{};
+    result += std::to_string(ts);
+    result += ':';
+    if (s < 10) result += '0';
+    result += std::to_string(s);
+    result += '.';
+    result += std::to_string(t);
+    os << result;
+}
+
+bool Clock::operator-=(int steps) {
+    while (steps > 0) {
+        if (!this->operator bool())
+            return false;
+        --*this;
+        --steps;
+    }
+    return true;
+}
+
+} // namespace plain_int
+
+namespace pointer_chain { // Step 08
+
+class DownCounter {
+    int value_{};
+    const int reset_{};
+    DownCounter* next_{};
+public:
+    DownCounter() =default;
+    DownCounter(int reset, DownCounter* next = nullptr)
+        : reset_{reset}, next_{next}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const;
+    void step();
+};
+
+void DownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool DownCounter::is_counting() const {
+     return (value_ != 0)
+         || (next_ && next_->is_counting());
+}
+
+void DownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (next_ && next_->is_counting()) {
+            next_->step();
+            value_ = reset_-1;
+        }
+    }
+}
+
+class Clock {
+private:
+    DownCounter minutes_{1000};
+    DownCounter seconds_{60, &minutes_};
+    DownCounter tenthsecs_{10, &seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const; // (added for the comparison)
+    explicit operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+bool Clock::operator-=(int steps) {
+    while (steps > 0) {
+        if (!this->operator bool())
+            return false;
+        --*this;
+        --steps;
+    }
+    return true;
+}
+
+} // namespace pointer_chain
+
+namespace virtual_chain { // Step 09
+
+class BaseDownCounter {
+protected:
+    int value_{};
+    const int reset_{};
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    virtual bool is_counting() const;
+    virtual void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0);
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    BaseDownCounter& next_;
+public:
+    ChainableDownCounter(int limit, BaseDownCounter& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    bool is_counting() const override {
+        return (value_ > 0)
+            || next_.is_counting();
+    }
+    void step() override;
+};
+
+void ChainableDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (next_.is_counting()) {
+            next_.step();
+            value_ = reset_-1;
+        }
+    }
+}
+
+} // namespace virtual_chain
+
+namespace nvi_chain { // Step 10
+
+class BaseDownCounter {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    BaseDownCounter& next_;
+public:
+    ChainableDownCounter(int limit, BaseDownCounter& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+} // namespace nvi_chain
+
+namespace interface_chain { // Step 11 and Step 12
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+} // namespace interface_chain
+
+// The designs from Step 09 to Step 12 only differ in their counters,
+// the class `Clock` on top of them is the same in all these steps.
+
+template<typename BaseDownCounter, typename ChainableDownCounter>
+class ChainedClock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    ChainedClock() =default;
+    ChainedClock(const ChainedClock&)            =delete;
+    ChainedClock(ChainedClock&&)                 =delete;
+    ChainedClock& operator=(const ChainedClock&) =delete;
+    ChainedClock& operator=(ChainedClock&&)      =delete;
+    ~ChainedClock() =default;
+
+    void set(int ts) {
+        tenthsecs_.set(ts % 10); ts /= 10;
+        seconds_.set(ts % 60); ts /= 60;
+        minutes_.set(ts);
+    }
+    int get() const { // (added for the comparison)
+        return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+    }
+    explicit operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+    ChainedClock& operator--() {
+        tenthsecs_.step();
+        return *this;
+    }
+    bool operator-=(int steps) {
+        while (steps > 0) {
+            if (!this->operator bool())
+                return false;
+            --*this;
+            --steps;
+        }
+        return true;
+    }
+    void show(std::ostream& os = std::cout) const {
+        auto const saved_fill{os.fill()};
+        using std::setw;
+        using std::setfill;
+        os << setfill(' ') << setw(3) << minutes_.get() << ':'
+           << setfill('0') << setw(2) << seconds_.get() << '.'
+                           << setw(1) << tenthsecs_.get();
+        os.fill(saved_fill);
+    }
+};
+
+namespace virtual_chain {
+    using Clock = ChainedClock<BaseDownCounter, ChainableDownCounter>;
+}
+namespace nvi_chain {
+    using Clock = ChainedClock<BaseDownCounter, ChainableDownCounter>;
+}
+namespace interface_chain {
+    using Clock = ChainedClock<BaseDownCounter, ChainableDownCounter>;
+}
+
+#include <atomic>
+#include <type_traits>  // std::is_same
+#include <utility>      // std::move
+
+namespace hooked_chain { // Step 12a
+
+using interface_chain::I_DownCounting;
+using interface_chain::BaseDownCounter;
+
+struct NoRollover {
+    void operator()() const {/*empty*/}
+};
+
+template<typename Hook>
+constexpr bool is_hooked = !std::is_same<Hook, NoRollover>::value;
+
+template<typename OnRollover = NoRollover>
+class ChainableDownCounter : public BaseDownCounter,
+                             private OnRollover {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next,
+                         OnRollover on_rollover = {})
+        : BaseDownCounter{limit}, OnRollover{std::move(on_rollover)},
+          next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+        if constexpr (is_hooked<OnRollover>)
+            OnRollover::operator()();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+template<typename OnSecond = NoRollover,
+         typename OnMinute = NoRollover,
+         typename OnZero = NoRollover>
+class BasicClock : private OnZero {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter<OnMinute> seconds_;
+    ChainableDownCounter<OnSecond> tenthsecs_;
+public:
+    BasicClock(OnSecond on_second = {},
+               OnMinute on_minute = {},
+               OnZero on_zero = {})
+        : OnZero{std::move(on_zero)},
+          seconds_{60, minutes_, std::move(on_minute)},
+          tenthsecs_{10, seconds_, std::move(on_second)}
+    {/*empty*/}
+    BasicClock(const BasicClock&)            =delete;
+    BasicClock(BasicClock&&)                 =delete;
+    BasicClock& operator=(const BasicClock&) =delete;
+    BasicClock& operator=(BasicClock&&)      =delete;
+    ~BasicClock() =default;
+
+    void set(int ts) {
+        tenthsecs_.set(ts % 10); ts /= 10;
+        seconds_.set(ts % 60); ts /= 60;
+        minutes_.set(ts);
+    }
+    int get() const { // (added for the comparison)
+        return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+    }
+    explicit operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+    BasicClock& operator--() {
+        if constexpr (is_hooked<OnZero>) {
+            if (!tenthsecs_.is_counting())
+                return *this;
+            tenthsecs_.step();
+            if (!tenthsecs_.is_counting())
+                OnZero::operator()();
+        }
+        else
+            tenthsecs_.step();
+        return *this;
+    }
+    bool operator-=(int steps) {
+        while (steps > 0) {
+            if (!this->operator bool())
+                return false;
+            --*this;
+            --steps;
+        }
+        return true;
+    }
+};
+
+// (counting the hook calls, so that the code paths with hooks are
+// compared as well)
+struct CountCalls {
+    long* calls;
+    void operator()() const { ++*calls; }
+};
+
+using CountingClock = BasicClock<CountCalls, CountCalls, CountCalls>;
+
+class Clock : private CountingClock {
+    long calls_{};
+    using Base = CountingClock;
+public:
+    Clock() : Base{{&calls_}, {&calls_}, {&calls_}} {/*empty*/}
+    using Base::set;
+    using Base::get;
+    using Base::operator bool;
+    using Base::operator-=;
+    Clock& operator--() {
+        Base::operator--();
+        return *this;
+    }
+};
+
+} // namespace hooked_chain
+
+namespace bulk_subtract { // Step 12d
+
+using interface_chain::BaseDownCounter;
+using interface_chain::ChainableDownCounter;
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default;
+    Clock(const Clock&)            =delete;
+    Clock(Clock&&)                 =delete;
+    Clock& operator=(const Clock&) =delete;
+    Clock& operator=(Clock&&)      =delete;
+    ~Clock() =default;
+
+    void set(int ts) {
+        tenthsecs_.set(ts % 10); ts /= 10;
+        seconds_.set(ts % 60); ts /= 60;
+        minutes_.set(ts);
+    }
+    int get() const {
+        return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+    }
+    explicit operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+    Clock& operator--() {
+        tenthsecs_.step();
+        return *this;
+    }
+    bool operator-=(int steps) {
+        if (steps <= 0)
+            return true;
+        auto const remaining{get()};
+        set((steps < remaining) ? remaining - steps : 0);
+        return (steps <= remaining);
+    }
+};
+
+} // namespace bulk_subtract
+
+namespace seqlock_chain { // Step 12i
+
+using interface_chain::BaseDownCounter;
+using interface_chain::ChainableDownCounter;
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+    std::atomic<unsigned> sequence_{};
+    std::atomic<int> publishedMinutes_{};
+    std::atomic<int> publishedSeconds_{};
+    std::atomic<int> publishedTenthsecs_{};
+    void publish() {
+        auto const seq{sequence_.load(std::memory_order_relaxed)};
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        publishedMinutes_.store(minutes_.get(), std::memory_order_release);
+        publishedSeconds_.store(seconds_.get(), std::memory_order_release);
+        publishedTenthsecs_.store(tenthsecs_.get(),
+                                  std::memory_order_release);
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+public:
+    Clock() =default;
+    Clock(const Clock&)            =delete;
+    Clock(Clock&&)                 =delete;
+    Clock& operator=(const Clock&) =delete;
+    Clock& operator=(Clock&&)      =delete;
+    ~Clock() =default;
+
+    void set(int ts) {
+        tenthsecs_.set(ts % 10); ts /= 10;
+        seconds_.set(ts % 60); ts /= 60;
+        minutes_.set(ts);
+        publish();
+    }
+    // (the published value, as a reader in another thread sees it)
+    int get() const {
+        int minutes, seconds, tenthsecs;
+        unsigned before, after;
+        do {
+            before = sequence_.load(std::memory_order_acquire);
+            minutes = publishedMinutes_.load(std::memory_order_acquire);
+            seconds = publishedSeconds_.load(std::memory_order_acquire);
+            tenthsecs = publishedTenthsecs_.load(std::memory_order_acquire);
+            after = sequence_.load(std::memory_order_relaxed);
+        } while ((before & 1) || (before != after));
+        return (minutes*60 + seconds)*10 + tenthsecs;
+    }
+    explicit operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+    Clock& operator--() {
+        tenthsecs_.step();
+        publish();
+        return *this;
+    }
+    bool operator-=(int steps) {
+        bool counting{true};
+        while (steps > 0) {
+            if (!tenthsecs_.is_counting()) {
+                counting = false;
+                break;
+            }
+            tenthsecs_.step();
+            --steps;
+        }
+        publish();
+        return counting;
+    }
+};
+
+} // namespace seqlock_chain
+
+// --------------------------------------------------------------------
+// Equivalence check
+// --------------------------------------------------------------------
+
+#include <algorithm>    // std::min
+                        // std::max
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// All implementations are compared against the specification of a
+// clock counting tenth seconds (which is what `plain_int` implements,
+// but it is checked like any other): for every value from 0 to
+// `MaxTime` each clock is set to the value, then
+// - read back,
+// - stepped once and
+// - decremented with `-=` by each of a number of amounts.
+// After every operation its value, whether it still counts and the
+// result of `-=` must be as specified. The amounts are chosen to cross
+// all borrows (tenth seconds, seconds, minutes) and include the
+// boundaries (the value itself and one more). As `-=` is a loop of
+// single steps in most of the implementations (which take time in
+// proportion to the amount), large amounts and the boundaries are
+// only used for values below `LargeLimit` there; the implementations
+// with a bulk `-=` are checked with all amounts for all values.
+
+constexpr int LargeLimit{2000};
+
+template<typename Clock> constexpr bool has_bulk_subtract = false;
+template<> constexpr bool has_bulk_subtract<bulk_subtract::Clock> = true;
+
+struct Divergence {
+    int value{MaxTime + 1}; // (none found)
+    std::string clock{};
+    std::string operation{};
+    std::string expected{};
+    std::string actual{};
+};
+
+std::string describe(int value, bool counting) {
+    return std::to_string(value) + (counting ? " (counting)"
+                                             : " (not counting)");
+}
+
+std::string describe(int value, bool counting, bool result) {
+    return describe(value, counting) + ", returned "
+                                     + (result ? "true" : "false");
+}
+
+template<typename Clock>
+bool check(const char* name, Clock& clk, int v, Divergence& found) {
+    auto const diverges = [&](std::string operation, std::string expected,
+                              std::string actual) {
+        if (expected == actual)
+            return false;
+        found = {v, name, operation, expected, actual};
+        return true;
+    };
+    clk.set(v);
+    if (diverges("set(" + std::to_string(v) + ")",
+                 describe(v, v > 0),
+                 describe(clk.get(), static_cast<bool>(clk))))
+        return false;
+    clk.set(v);
+    --clk;
+    if (diverges("set(" + std::to_string(v) + "), --",
+                 describe(std::max(v - 1, 0), v > 1),
+                 describe(clk.get(), static_cast<bool>(clk))))
+        return false;
+    static const int small[]{-1, 0, 1, 2, 9, 10, 11};
+    static const int large[]{59, 60, 61, 599, 600, 601, 3'000, 18'000,
+                             36'000, 108'000};
+    auto const subtract = [&](int n) {
+        clk.set(v);
+        bool const result{clk -= n};
+        int const rest{(n <= 0) ? v : std::max(v - n, 0)};
+        return !diverges("set(" + std::to_string(v) + "), -= "
+                                + std::to_string(n),
+                         describe(rest, rest > 0, (n <= 0) || (n <= v)),
+                         describe(clk.get(), static_cast<bool>(clk), result));
+    };
+    for (auto const n : small)
+        if (!subtract(n))
+            return false;
+    if (has_bulk_subtract<Clock> || (v < LargeLimit)) {
+        for (auto const n : large)
+            if (!subtract(n))
+                return false;
+        for (auto const n : {v - 1, v, v + 1})
+            if (!subtract(n))
+                return false;
+    }
+    return true;
+}
+
+// Checks all implementations for the values [from, to), returns
+// `false` at the first divergence.
+
+bool check_range(int from, int to, Divergence& found) {
+    plain_int::Clock plainInt{};
+    pointer_chain::Clock pointerChain{};
+    virtual_chain::Clock virtualChain{};
+    nvi_chain::Clock nviChain{};
+    interface_chain::Clock interfaceChain{};
+    hooked_chain::Clock hookedChain{};
+    bulk_subtract::Clock bulkSubtract{};
+    seqlock_chain::Clock seqlockChain{};
+    for (int v{from}; v < to; ++v)
+        if (!check("plain_int (Step 01-07)", plainInt, v, found)
+         || !check("pointer_chain (Step 08)", pointerChain, v, found)
+         || !check("virtual_chain (Step 09)", virtualChain, v, found)
+         || !check("nvi_chain (Step 10)", nviChain, v, found)
+         || !check("interface_chain (Step 11-12)", interfaceChain, v, found)
+         || !check("hooked_chain (Step 12a)", hookedChain, v, found)
+         || !check("bulk_subtract (Step 12d)", bulkSubtract, v, found)
+         || !check("seqlock_chain (Step 12i)", seqlockChain, v, found))
+            return false;
+    return true;
+}
+
+constexpr int Implementations{8};
+
+// Distributes the values in chunks over `threads` threads and returns
+// the divergence at the smallest value (if any). Chunks beyond a
+// divergence already found are skipped.
+
+Divergence check_all(unsigned threads) {
+    constexpr int ChunkSize{4096};
+    std::atomic<int> next{0};
+    std::atomic<int> firstBad{MaxTime + 1};
+    std::mutex mutex{};
+    Divergence first{};
+    std::vector<std::thread> workers{};
+    for (unsigned t{}; t < threads; ++t)
+        workers.emplace_back([&]{
+            for (int from; (from = next.fetch_add(ChunkSize)) <= MaxTime; ) {
+                if (from >= firstBad)
+                    break;
+                Divergence found{};
+                if (check_range(from, std::min(from + ChunkSize, MaxTime + 1),
+                                found))
+                    continue;
+                std::lock_guard<std::mutex> lock{mutex};
+                if (found.value < first.value) {
+                    first = found;
+                    firstBad = found.value;
+                }
+            }
+        });
+    for (auto& w : workers)
+        w.join();
+    return first;
+}
+
+#if 0
+
+#include <cassert>
+
+void test_detects_divergence() {
+    // (a bug introduced on purpose: decrementing 1:00.0 yields 0:59.0)
+    struct Broken : plain_int::Clock {
+        Broken& operator--() {
+            if (get() == 600)
+                set(590);
+            else
+                plain_int::Clock::operator--();
+            return *this;
+        }
+    } broken{};
+    Divergence found{};
+    assert(check("plain_int", broken, 599, found));
+    assert(!check("broken", broken, 600, found));
+    assert(found.value == 600);
+    assert(found.operation == "set(600), --");
+    assert(found.expected == "599 (counting)");
+    assert(found.actual == "590 (counting)");
+}
+
+void test_boundaries() {
+    Divergence found{};
+    assert(check_range(0, 1000, found));
+    assert(check_range(MaxTime - 1000, MaxTime + 1, found));
+    assert(found.value == MaxTime + 1);
+}
+
+int main() {
+    test_detects_divergence();
+    test_boundaries();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+// Usage: Step_12u [threads]
+
+int main(int argc, char* argv[]) {
+    unsigned threads{std::max(1u, std::thread::hardware_concurrency())};
+    if (argc == 2)
+        threads = std::max(1, std::atoi(argv[1]));
+    auto const start{std::chrono::steady_clock::now()};
+    auto const first{check_all(threads)};
+    std::chrono::duration<double> const elapsed{
+                                    std::chrono::steady_clock::now() - start};
+    if (first.value <= MaxTime) {
+        std::cout << "*** DIVERGENCE at value " << first.value << '\n'
+                  << "clock:     " << first.clock << '\n'
+                  << "operation: " << first.operation << '\n'
+                  << "expected:  " << first.expected << '\n'
+                  << "actual:    " << first.actual << std::endl;
+        return 1;
+    }
+    std::cout << "*** all " << Implementations << " implementations agree"
+                 " for all values 0.." << MaxTime << " ("
+              << threads << " threads, " << elapsed.count() << " seconds)"
+              << std::endl;
+}
+
+#endif
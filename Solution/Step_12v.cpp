@@ -0,0 +1,348 @@
+#include <array>    // std::array
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+
+// This sideline makes the counters and the `Clock` of Step 12 usable
+// in constant expressions: everything except `show` is `constexpr`,
+// so the state sequences checked by the tests of Step 11 are checked
+// by the compiler (with `static_assert`), and tables derived from the
+// behavior of a clock are computed at compile time.
+//
+// Virtual member functions can only be `constexpr` since C++20, hence
+// this file requires to be compiled with `-std=c++20` (or later).
+// Furthermore a class with a virtual base class can not have a
+// `constexpr` constructor, so `BaseDownCounter` derives from
+// `I_DownCounting` non-virtually (as there is only one path to the
+// interface anyway, this makes no difference).
+
+#if __cplusplus < 202002L
+#error "constexpr virtual member functions require C++20"
+#endif
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    constexpr virtual bool is_counting() const =0;
+    constexpr virtual void step() =0;
+};
+
+class BaseDownCounter : public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    constexpr virtual bool chained_is_counting() const { return false; }
+    constexpr virtual void chained_needs_step() {}
+public:
+    constexpr BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    constexpr int get() const { return value_; }
+    constexpr void set(int);
+    constexpr bool is_counting() const final;
+    constexpr void step();
+};
+
+constexpr void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+constexpr bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+constexpr void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    constexpr ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    constexpr void chained_needs_step() override {
+        next_.step();
+    }
+    constexpr bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    constexpr Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    constexpr ~Clock() =default;
+
+    constexpr void set(int);
+    constexpr int get() const;
+    constexpr operator bool() const;
+    constexpr Clock& operator--();
+    constexpr bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+constexpr void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+constexpr int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+constexpr Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+constexpr Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+constexpr bool Clock::operator-=(int steps) {
+    while (steps > 0) {
+        if (!this->operator bool())
+            return false;
+        --*this;
+        --steps;
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------
+// Tests (evaluated by the compiler)
+// --------------------------------------------------------------------
+// These are the tests of Step 11, only the functions are `constexpr`
+// now and return `true`, so that they can be called in a
+// `static_assert`. A failing `assert` in a constant expression is not
+// a constant expression, hence the compilation fails with the line
+// number of the `assert` in the error message.
+//
+// (Calling them at run time as well allows to step through them with
+// the debugger, see the conditionally compiled part at the end.)
+
+#include <cassert>
+
+constexpr bool test_single_stage() {
+    BaseDownCounter c0{5};
+    assert(c0.get() == 0); assert(c0.is_counting() == false);
+    c0.set(3);
+    assert(c0.get() == 3); assert(c0.is_counting() == true);
+    c0.step();
+    assert(c0.get() == 2); assert(c0.is_counting() == true);
+    c0.step();
+    assert(c0.get() == 1); assert(c0.is_counting() == true);
+    c0.step();
+    assert(c0.get() == 0); assert(c0.is_counting() == false);
+    c0.step();
+    assert(c0.get() == 0); assert(c0.is_counting() == false);
+    c0.set(7);
+    assert(c0.get() == 4); assert(c0.is_counting() == true);
+    return true;
+}
+
+constexpr bool test_double_stage() {
+    BaseDownCounter c0{5};
+    ChainableDownCounter c1{2, c0};
+    c0.set(3);      assert(c0.get() == 3);
+                    assert(c1.get() == 0);
+    c1.step();      assert(c0.get() == 2);
+                    assert(c1.get() == 1);
+    c1.step();      assert(c0.get() == 2);
+                    assert(c1.get() == 0);
+    c1.step();      assert(c0.get() == 1);
+                    assert(c1.get() == 1);
+    c1.step();      assert(c0.get() == 1);
+                    assert(c1.get() == 0);
+    c1.step();      assert(c0.get() == 0);
+                    assert(c1.get() == 1);
+    c1.step();      assert(c0.get() == 0);
+                    assert(c1.get() == 0);
+    c1.step();      assert(c0.get() == 0);
+                    assert(c1.get() == 0);
+    return true;
+}
+
+constexpr bool test_triple_stage() {
+    BaseDownCounter c0{2};          c0.set(1); assert(c0.get() == 1);
+    ChainableDownCounter c1{2, c0}; c1.set(1); assert(c1.get() == 1);
+    ChainableDownCounter c2{2, c1}; c2.set(1); assert(c2.get() == 1);
+    c2.step();                                 assert(c0.get() == 1);
+                                               assert(c1.get() == 1);
+                                               assert(c2.get() == 0);
+    c2.step();                                 assert(c0.get() == 1);
+                                               assert(c1.get() == 0);
+                                               assert(c2.get() == 1);
+    c2.step();                                 assert(c0.get() == 1);
+                                               assert(c1.get() == 0);
+                                               assert(c2.get() == 0);
+    c2.step();                                 assert(c0.get() == 0);
+                                               assert(c1.get() == 1);
+                                               assert(c2.get() == 1);
+    c2.step();                                 assert(c0.get() == 0);
+                                               assert(c1.get() == 1);
+                                               assert(c2.get() == 0);
+    c2.step();                                 assert(c0.get() == 0);
+                                               assert(c1.get() == 0);
+                                               assert(c2.get() == 1);
+    c2.step();                                 assert(c0.get() == 0);
+                                               assert(c1.get() == 0);
+                                               assert(c2.get() == 0);
+    c2.step();                                 assert(c0.get() == 0);
+                                               assert(c1.get() == 0);
+                                               assert(c2.get() == 0);
+    return true;
+}
+
+class AutoResetter : public I_DownCounting {
+public:
+    constexpr bool is_counting() const { return true; }
+    constexpr void step() {/*empty*/}
+};
+
+constexpr bool test_auto_resetter() {
+    AutoResetter reset{};
+    ChainableDownCounter c0{4, reset};
+    c0.set(2);  assert(c0.get() == 2); assert(c0.is_counting() == true);
+    c0.step();  assert(c0.get() == 1); assert(c0.is_counting() == true);
+    c0.step();  assert(c0.get() == 0); assert(c0.is_counting() == true);
+    c0.step();  assert(c0.get() == 3); assert(c0.is_counting() == true);
+    c0.step();  assert(c0.get() == 2); assert(c0.is_counting() == true);
+    return true;
+}
+
+constexpr bool test_clock() {
+    Clock clk{};
+    assert(clk.get() == 0); assert(!clk);
+    clk.set(10*60*10 + 1); // 10:00.1
+    --clk;                 assert(clk.get() == 10*60*10); assert(clk);
+    --clk;                 assert(clk.get() == 9*60*10 + 59*10 + 9);
+    assert(clk -= 9*60*10 + 59*10 + 8);
+                           assert(clk.get() == 1); assert(clk);
+    assert(!(clk -= 2));   assert(clk.get() == 0); assert(!clk);
+    clk.set(1000*60*10);   assert(clk.get() == 999*60*10); // (minutes clamped)
+    return true;
+}
+
+static_assert(test_single_stage());
+static_assert(test_double_stage());
+static_assert(test_triple_stage());
+static_assert(test_auto_resetter());
+static_assert(test_clock());
+
+// --------------------------------------------------------------------
+// Tables computed at compile time
+// --------------------------------------------------------------------
+// The time left on a clock after each of the digit commands (which
+// advance the clock of the player to draw by 0.1 second up to 3 hours)
+// starting from `InitialTime`. It is computed by actually running a
+// `Clock`, so it is exactly what the chess clock will show, though
+// it costs nothing at run time.
+
+struct DigitCommand {
+    int ticks;
+    int timeLeft;   // (after the command from `InitialTime`)
+    bool counting;  // (result of `-=`)
+};
+
+constexpr int ticks_for(char digit) {
+    switch (digit) {
+    case '9': return 108'000; // (3 hours)
+    case '8': return 36'000;  // (1 hour)
+    case '7': return 18'000;  // (30 minutes)
+    case '6': return 3'000;   // (5 minutes)
+    case '5': return 600;     // (1 minute)
+    case '4': return 150;     // (15 seconds)
+    case '3': return 50;      // (5 seconds)
+    case '2': return 10;      // (1 second)
+    case '1': return 1;       // (0.1 second)
+    default:  return 0;
+    }
+}
+
+constexpr auto make_digit_commands() {
+    std::array<DigitCommand, 10> table{};
+    for (char digit{'0'}; digit <= '9'; ++digit) {
+        Clock clk{};
+        clk.set(InitialTime);
+        auto const ticks{ticks_for(digit)};
+        bool const counting{clk -= ticks};
+        table[digit - '0'] = {ticks, clk.get(), counting};
+    }
+    return table;
+}
+
+constexpr auto DigitCommands{make_digit_commands()};
+
+static_assert(DigitCommands[0].timeLeft == InitialTime);
+static_assert(DigitCommands[5].timeLeft == InitialTime - 600);
+static_assert(DigitCommands[7].timeLeft == 0 && DigitCommands[7].counting);
+static_assert(DigitCommands[9].timeLeft == 0 && !DigitCommands[9].counting);
+
+#if 0
+
+int main() {
+    // (the same tests at run time, e.g. to step through with a debugger)
+    test_single_stage();
+    test_double_stage();
+    test_triple_stage();
+    test_auto_resetter();
+    test_clock();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+int main() {
+    Clock clk{};
+    clk.set(InitialTime);
+    std::cout << "digit commands starting from " << clk
+              << " (computed at compile time)\n";
+    for (char digit{'0'}; digit <= '9'; ++digit) {
+        auto const& cmd{DigitCommands[digit - '0']};
+        clk.set(cmd.timeLeft);
+        std::cout << digit << ": " << std::setw(7) << cmd.ticks
+                  << " ticks ->" << clk
+                  << (cmd.counting ? "" : " (time is up)") << '\n';
+    }
+    std::cout.flush();
+}
+
+#endif
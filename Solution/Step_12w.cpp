@@ -0,0 +1,794 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+enum class GameState {
+    Initial, Startable,
+    WhitePaused, BlackPaused,
+    WhiteDraw, BlackDraw,
+    WhiteWins, BlackWins
+};
+
+const char* to_string(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "Initial";
+    case GameState::Startable:   return "Startable";
+    case GameState::WhitePaused: return "WhitePaused";
+    case GameState::BlackPaused: return "BlackPaused";
+    case GameState::WhiteDraw:   return "WhiteDraw";
+    case GameState::BlackDraw:   return "BlackDraw";
+    case GameState::WhiteWins:   return "WhiteWins";
+    case GameState::BlackWins:   return "BlackWins";
+    }
+    return "?";
+}
+
+// The FSM formerly coded inside of `runChessClock` is moved into a
+// class of its own, so that it can be driven by the interactive loop
+// as well as by the headless batch mode. Commands not valid in the
+// current state are ignored (ie. `process` returns `false`).
+
+class ChessClock {
+    Clock blackPlayerClock_{};
+    Clock whitePlayerClock_{};
+    GameState theGameState_{GameState::Initial};
+public:
+    GameState state() const { return theGameState_; }
+    int blackTime() const { return blackPlayerClock_.get(); }
+    int whiteTime() const { return whitePlayerClock_.get(); }
+    bool process(char command);
+    void show(std::ostream&) const;
+};
+
+bool ChessClock::process(char command) {
+    int ticksToSimulate{};
+    switch(command) {
+        case 'r':
+            if (not (theGameState_ == GameState::Initial
+                  || theGameState_ == GameState::BlackWins
+                  || theGameState_ == GameState::WhiteWins
+                  || theGameState_ == GameState::BlackPaused
+                  || theGameState_ == GameState::WhitePaused))
+                  return false;
+            blackPlayerClock_.set(InitialTime);
+            whitePlayerClock_.set(InitialTime);
+            theGameState_ = GameState::Startable;
+            break;
+        case 's': // start clock (white draws first)
+            if (not (theGameState_ == GameState::Startable))
+                return false;
+            theGameState_ = GameState::WhiteDraw;
+            break;
+        case 'p':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::BlackPaused;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::WhitePaused;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'c': // coninue game
+            switch (theGameState_) {
+            case GameState::BlackPaused:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            case GameState::WhitePaused:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case 'x':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                theGameState_ = GameState::WhiteDraw;
+                break;
+            case GameState::WhiteDraw:
+                theGameState_ = GameState::BlackDraw;
+                break;
+            default:
+                return false;
+            }
+            break;
+        case '9': ticksToSimulate||(ticksToSimulate = 108'000); // (3 hours)
+        case '8': ticksToSimulate||(ticksToSimulate = 36'000); // (1 hour)
+        case '7': ticksToSimulate||(ticksToSimulate = 18'000); // (30 minutes)
+        case '6': ticksToSimulate||(ticksToSimulate = 3'000); // (5 minutes)
+        case '5': ticksToSimulate||(ticksToSimulate = 600); // (1 minute)
+        case '4': ticksToSimulate||(ticksToSimulate = 150); // (15 seconds)
+        case '3': ticksToSimulate||(ticksToSimulate = 50); // (5 seconds)
+        case '2': ticksToSimulate||(ticksToSimulate = 10); // (1 second)
+        case '1': ticksToSimulate||(ticksToSimulate = 1); // (0.1 second)
+        case '0':
+            switch (theGameState_) {
+            case GameState::BlackDraw:
+                blackPlayerClock_ -= ticksToSimulate;
+                if (!blackPlayerClock_)
+                    theGameState_ = GameState::WhiteWins;
+                break;
+            case GameState::WhiteDraw:
+                whitePlayerClock_ -= ticksToSimulate;
+                if (!whitePlayerClock_)
+                    theGameState_ = GameState::BlackWins;
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void ChessClock::show(std::ostream& clkout) const {
+    clkout << "B:" << blackPlayerClock_
+                << ((theGameState_ == GameState::BlackDraw) ? "*" : " ")
+                << "| "
+                << "W:" << whitePlayerClock_
+                << ((theGameState_ == GameState::WhiteDraw) ? "*" : " ")
+                << std::endl;
+    switch (theGameState_) {
+    case GameState::BlackWins:
+        clkout << "!! Black Player Won !!" << std::endl;
+        break;
+    case GameState::WhiteWins:
+        clkout << "!! White Player Won !!" << std::endl;
+        break;
+    default: ;//avoid warning
+    }
+}
+
+// --------------------------------------------------------------------
+// Stress engine
+// --------------------------------------------------------------------
+// Plays random games against the FSM of `ChessClock` and checks after
+// each command that the FSM stays within its rules:
+// - a rejected command changes nothing,
+// - only the clock of the player to draw decreases (and only by the
+//   ticks of the digit command, down to zero),
+// - paused clocks don't move,
+// - a player wins exactly when the clock of the other runs out, and
+//   the game stays won until it is reset with 'r',
+// - 'r' sets both clocks to the initial time and 's' only starts a
+//   game that was reset.
+//
+// Every game has a pseudo random generator of its own, seeded from
+// the seed of the run and the number of the game, so that each game
+// can be replayed on its own, independently of how the games were
+// distributed over the threads.
+
+#include <algorithm>    // std::min
+                        // std::max
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>      // std::uint64_t
+#include <cstring>      // std::strlen
+                        // std::strchr
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// (SplitMix64, which is much cheaper to seed than `std::mt19937` and
+// thus allows a generator per game)
+
+class GameRandom {
+    std::uint64_t state_;
+public:
+    explicit GameRandom(std::uint64_t seed, std::uint64_t game)
+        : state_{seed ^ (game * 0x9e3779b97f4a7c15u)}
+    {/*empty*/}
+    std::uint64_t operator()() {
+        auto z{state_ += 0x9e3779b97f4a7c15u};
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+        return z ^ (z >> 31);
+    }
+    int below(int n) {
+        return static_cast<int>(operator()() % static_cast<unsigned>(n));
+    }
+};
+
+int ticks_for(char command) {
+    switch (command) {
+    case '9': return 108'000;
+    case '8': return 36'000;
+    case '7': return 18'000;
+    case '6': return 3'000;
+    case '5': return 600;
+    case '4': return 150;
+    case '3': return 50;
+    case '2': return 10;
+    case '1': return 1;
+    default:  return 0;
+    }
+}
+
+bool is_digit(char command) {
+    return (command >= '0') && (command <= '9');
+}
+
+// The commands valid in each state (in the order of `GameState`).
+
+const char* valid_commands(GameState state) {
+    switch (state) {
+    case GameState::Initial:     return "r";
+    case GameState::Startable:   return "s";
+    case GameState::WhitePaused: return "rc";
+    case GameState::BlackPaused: return "rc";
+    case GameState::WhiteDraw:   return "px0123456789";
+    case GameState::BlackDraw:   return "px0123456789";
+    case GameState::WhiteWins:   return "r";
+    case GameState::BlackWins:   return "r";
+    }
+    return "";
+}
+
+// Different kinds of command streams (chosen at random per game), as
+// uniformly random commands rarely get far into a game:
+// - `Uniform` picks from all commands (and some which are none),
+// - `ValidOnly` picks only commands valid in the current state, so
+//   that games are played to the end,
+// - `Bursts` repeats the same command several times,
+// - `Endgame` mostly advances the clocks by large amounts, so that
+//   games are won quickly (and commands hit the won state).
+
+enum class Strategy { Uniform, ValidOnly, Bursts, Endgame };
+
+constexpr int StrategyCount{4};
+constexpr int MaxGameLength{256};
+
+const char* to_string(Strategy strategy) {
+    switch (strategy) {
+    case Strategy::Uniform:   return "Uniform";
+    case Strategy::ValidOnly: return "ValidOnly";
+    case Strategy::Bursts:    return "Bursts";
+    case Strategy::Endgame:   return "Endgame";
+    }
+    return "?";
+}
+
+class CommandStream {
+    GameRandom& rng_;
+    Strategy const strategy_;
+    char burst_{};
+    int burstLeft_{};
+    char pick(const char* from, int n) { return from[rng_.below(n)]; }
+public:
+    CommandStream(GameRandom& rng)
+        : rng_{rng},
+          strategy_{static_cast<Strategy>(rng.below(StrategyCount))}
+    {/*empty*/}
+    Strategy strategy() const { return strategy_; }
+    char next(GameState state) {
+        static const char all[]{"rspcx0123456789az?"};
+        static const char large[]{"789x"};
+        switch (strategy_) {
+        case Strategy::Uniform:
+            return pick(all, sizeof all - 1);
+        case Strategy::ValidOnly: {
+            auto const valid{valid_commands(state)};
+            return pick(valid, static_cast<int>(std::strlen(valid)));
+        }
+        case Strategy::Bursts:
+            if (burstLeft_ == 0) {
+                burst_ = pick(all, sizeof all - 1);
+                burstLeft_ = 1 + rng_.below(20);
+            }
+            --burstLeft_;
+            return burst_;
+        case Strategy::Endgame:
+            if (rng_.below(4) == 0)
+                return pick(all, sizeof all - 1);
+            return pick(large, sizeof large - 1);
+        }
+        return '?';
+    }
+};
+
+// Returns an empty string if the transition from `before` to `after`
+// caused by `command` is within the rules, otherwise a description of
+// the violation.
+
+struct Observed {
+    GameState state;
+    int blackTime;
+    int whiteTime;
+};
+
+template<typename FSM>
+Observed observe(const FSM& fsm) {
+    return {fsm.state(), fsm.blackTime(), fsm.whiteTime()};
+}
+
+std::string check_transition(const Observed& before, char command,
+                             bool accepted, const Observed& after) {
+    bool const unchanged{(after.state == before.state)
+                      && (after.blackTime == before.blackTime)
+                      && (after.whiteTime == before.whiteTime)};
+    if (!accepted)
+        return unchanged ? "" : "rejected command changed the clock";
+    bool const won{(before.state == GameState::WhiteWins)
+                || (before.state == GameState::BlackWins)};
+    if (won && (command != 'r'))
+        return "command accepted after the game was won";
+    bool const paused{(before.state == GameState::WhitePaused)
+                   || (before.state == GameState::BlackPaused)};
+    if (paused && is_digit(command))
+        return "paused clock moved";
+    if (std::strchr(valid_commands(before.state), command) == nullptr)
+        return "invalid command accepted";
+    switch (command) {
+    case 'r':
+        if ((after.blackTime != InitialTime)
+         || (after.whiteTime != InitialTime))
+            return "reset did not set the initial time";
+        return (after.state == GameState::Startable)
+                    ? "" : "reset did not make the game startable";
+    case 's':
+        return (after.state == GameState::WhiteDraw)
+                    ? "" : "white does not draw first";
+    case 'p':
+    case 'c':
+    case 'x': {
+        if ((after.blackTime != before.blackTime)
+         || (after.whiteTime != before.whiteTime))
+            return "clock moved without a digit command";
+        bool const white{(before.state == GameState::WhiteDraw)
+                      || (before.state == GameState::WhitePaused)};
+        switch (command) {
+        case 'p':
+            return (after.state == (white ? GameState::WhitePaused
+                                          : GameState::BlackPaused))
+                        ? "" : "pause did not pause the player to draw";
+        case 'c':
+            return (after.state == (white ? GameState::WhiteDraw
+                                          : GameState::BlackDraw))
+                        ? "" : "continue did not resume the paused player";
+        default:
+            return (after.state == (white ? GameState::BlackDraw
+                                          : GameState::WhiteDraw))
+                        ? "" : "switch did not pass the draw to the other";
+        }
+    }
+    default:
+        if (!is_digit(command))
+            return ((after.blackTime == before.blackTime)
+                 && (after.whiteTime == before.whiteTime))
+                        ? "" : "clock moved without a digit command";
+    }
+    bool const whiteDraws{before.state == GameState::WhiteDraw};
+    auto const active{whiteDraws ? before.whiteTime : before.blackTime};
+    auto const activeAfter{whiteDraws ? after.whiteTime : after.blackTime};
+    auto const other{whiteDraws ? before.blackTime : before.whiteTime};
+    auto const otherAfter{whiteDraws ? after.blackTime : after.whiteTime};
+    if (otherAfter != other)
+        return "clock of the player not to draw moved";
+    if (activeAfter != std::max(active - ticks_for(command), 0))
+        return "clock of the player to draw moved wrongly";
+    auto const expected{(activeAfter > 0) ? before.state
+                      : whiteDraws ? GameState::BlackWins
+                                   : GameState::WhiteWins};
+    return (after.state == expected)
+                ? "" : "wrong state after the clock moved";
+}
+
+// The result of playing a number of games; `failedGame` is the
+// smallest number of a game violating the rules (or -1).
+
+struct StressResult {
+    long long games{};
+    long long commands{};
+    long long accepted{};
+    long long won{};
+    std::array<long long, StrategyCount> perStrategy{};
+    long long failedGame{-1};
+    std::string failedCommands{};
+    std::string violation{};
+    void merge(const StressResult&);
+    void show(std::ostream&, std::uint64_t seed,
+              std::chrono::duration<double>) const;
+};
+
+void StressResult::merge(const StressResult& other) {
+    games += other.games;
+    commands += other.commands;
+    accepted += other.accepted;
+    won += other.won;
+    for (int i{}; i < StrategyCount; ++i)
+        perStrategy[i] += other.perStrategy[i];
+    if ((other.failedGame >= 0)
+     && ((failedGame < 0) || (other.failedGame < failedGame))) {
+        failedGame = other.failedGame;
+        failedCommands = other.failedCommands;
+        violation = other.violation;
+    }
+}
+
+void StressResult::show(std::ostream& os, std::uint64_t seed,
+                        std::chrono::duration<double> elapsed) const {
+    os << "seed:               " << seed << '\n'
+       << "games played:       " << games << '\n'
+       << "commands processed: " << commands << '\n'
+       << "commands accepted:  " << accepted << '\n'
+       << "games won:          " << won << '\n'
+       << "games by strategy: ";
+    for (int i{}; i < StrategyCount; ++i)
+        os << ' ' << to_string(static_cast<Strategy>(i))
+           << '=' << perStrategy[i];
+    os << '\n'
+       << "elapsed seconds:    " << elapsed.count() << '\n'
+       << "games/second:       " << games / elapsed.count() << '\n'
+       << "commands/second:    " << commands / elapsed.count() << '\n';
+    if (failedGame >= 0)
+        os << "*** VIOLATION in game " << failedGame << ": " << violation
+           << "\n    commands: " << failedCommands
+           << "\n    replay with: --replay " << seed << ' ' << failedGame
+           << '\n';
+    os.flush();
+}
+
+// Plays a single game (`FSM` is a template argument only to allow
+// the tests to check the engine with a broken FSM).
+
+template<typename FSM = ChessClock>
+bool play_game(std::uint64_t seed, long long game, StressResult& result,
+               std::ostream* replay = nullptr) {
+    GameRandom rng{seed, static_cast<std::uint64_t>(game)};
+    CommandStream stream{rng};
+    FSM fsm{};
+    ++result.games;
+    ++result.perStrategy[static_cast<int>(stream.strategy())];
+    auto const length{1 + rng.below(MaxGameLength)};
+    bool won{};
+    for (int n{}; n < length; ++n) {
+        auto const before{observe(fsm)};
+        char const command{stream.next(before.state)};
+        bool const accepted{fsm.process(command)};
+        auto const after{observe(fsm)};
+        ++result.commands;
+        result.accepted += accepted;
+        won |= (after.state == GameState::WhiteWins)
+            || (after.state == GameState::BlackWins);
+        if (replay) {
+            *replay << "===> " << command
+                    << (accepted ? "" : " (rejected)") << '\n';
+            fsm.show(*replay);
+        }
+        auto const violation{check_transition(before, command, accepted,
+                                              after)};
+        if (!violation.empty()) {
+            // (regenerating the commands is cheap, as it only happens
+            // once per failing game)
+            GameRandom again{seed, static_cast<std::uint64_t>(game)};
+            CommandStream commands{again};
+            FSM fresh{};
+            again.below(MaxGameLength);
+            result.failedCommands.clear();
+            for (int i{}; i <= n; ++i) {
+                char const c{commands.next(fresh.state())};
+                result.failedCommands += c;
+                fresh.process(c);
+            }
+            result.failedGame = game;
+            result.violation = violation;
+            return false;
+        }
+    }
+    result.won += won;
+    return true;
+}
+
+// Plays the games [0, games) distributed in chunks over `threads`
+// threads. Chunks beyond a game already failed are skipped, so the
+// first failing game is found independent of the number of threads.
+
+template<typename FSM = ChessClock>
+StressResult stress(std::uint64_t seed, long long games, unsigned threads) {
+    constexpr long long ChunkSize{4096};
+    std::atomic<long long> next{0};
+    std::atomic<long long> firstFailed{games};
+    std::vector<StressResult> results(threads);
+    std::vector<std::thread> workers{};
+    for (unsigned t{}; t < threads; ++t)
+        workers.emplace_back([&, t]{
+            auto& result{results[t]};
+            for (long long from; (from = next.fetch_add(ChunkSize)) < games; ) {
+                auto const to{std::min(from + ChunkSize, games)};
+                for (auto game{from}; game < to; ++game) {
+                    if (game >= firstFailed)
+                        break;
+                    if (play_game<FSM>(seed, game, result))
+                        continue;
+                    auto failed{firstFailed.load()};
+                    while ((game < failed)
+                        && !firstFailed.compare_exchange_weak(failed, game))
+                        ;
+                    break;
+                }
+            }
+        });
+    StressResult total{};
+    for (unsigned t{}; t < threads; ++t) {
+        workers[t].join();
+        total.merge(results[t]);
+    }
+    return total;
+}
+
+#if 0
+
+#include <cassert>
+#include <sstream>
+
+// (a bug introduced on purpose: digit commands move a paused clock)
+
+class MovesWhenPaused : public ChessClock {
+public:
+    bool process(char command) {
+        bool const paused{(state() == GameState::WhitePaused)
+                       || (state() == GameState::BlackPaused)};
+        if (paused && (command == '5')) {
+            ChessClock::process('c');
+            ChessClock::process(command);
+            return ChessClock::process('p');
+        }
+        return ChessClock::process(command);
+    }
+};
+
+void test_check_transition() {
+    Observed const draw{GameState::WhiteDraw, 100, 50};
+    assert(check_transition(draw, '3', true,
+                            {GameState::WhiteDraw, 100, 0})
+                == "wrong state after the clock moved");
+    assert(check_transition(draw, '3', true,
+                            {GameState::BlackWins, 100, 0}) == "");
+    assert(check_transition(draw, '2', true,
+                            {GameState::WhiteDraw, 100, 40}) == "");
+    assert(check_transition(draw, '2', true,
+                            {GameState::WhiteDraw, 90, 50})
+                == "clock of the player not to draw moved");
+    assert(check_transition(draw, 'r', false, draw) == "");
+    assert(check_transition(draw, 'r', false,
+                            {GameState::Startable, 100, 50})
+                == "rejected command changed the clock");
+    assert(check_transition(draw, 'p', true,
+                            {GameState::WhitePaused, 100, 50}) == "");
+    assert(check_transition(draw, 'p', true, draw)
+                == "pause did not pause the player to draw");
+    assert(check_transition(draw, 'x', true,
+                            {GameState::BlackDraw, 100, 50}) == "");
+    assert(check_transition(draw, 'x', true, draw)
+                == "switch did not pass the draw to the other");
+    assert(check_transition(draw, 'x', true,
+                            {GameState::BlackDraw, 100, 49})
+                == "clock moved without a digit command");
+    Observed const paused{GameState::BlackPaused, 100, 50};
+    assert(check_transition(paused, 'c', true,
+                            {GameState::BlackDraw, 100, 50}) == "");
+    assert(check_transition(paused, 'c', true,
+                            {GameState::WhiteDraw, 100, 50})
+                == "continue did not resume the paused player");
+    Observed const won{GameState::BlackWins, 100, 0};
+    assert(check_transition(won, 'x', true, won)
+                == "command accepted after the game was won");
+    assert(check_transition(won, 'r', true,
+                            {GameState::Startable, InitialTime, InitialTime})
+                == "");
+}
+
+void test_reproducible() {
+    StressResult one{}, two{};
+    std::ostringstream replayOne{}, replayTwo{};
+    for (long long game{}; game < 100; ++game) {
+        assert(play_game(42, game, one, &replayOne));
+        assert(play_game(42, game, two, &replayTwo));
+    }
+    assert(one.commands == two.commands);
+    assert(replayOne.str() == replayTwo.str());
+    auto const a{stress(7, 20'000, 1)};
+    auto const b{stress(7, 20'000, 3)};
+    assert(a.failedGame < 0);
+    assert((a.commands == b.commands) && (a.accepted == b.accepted));
+    assert(a.won > 0);
+    for (auto const n : a.perStrategy)
+        assert(n > 0);
+}
+
+void test_detects_violation() {
+    auto const one{stress<MovesWhenPaused>(7, 20'000, 1)};
+    auto const two{stress<MovesWhenPaused>(7, 20'000, 4)};
+    assert(one.failedGame >= 0);
+    assert(one.failedGame == two.failedGame);
+    assert(one.violation == "paused clock moved");
+    // (the commands recorded end with the offending '5' after a 'p')
+    auto const& commands{one.failedCommands};
+    assert(commands.back() == '5');
+    StressResult replayed{};
+    assert(!play_game<MovesWhenPaused>(7, one.failedGame, replayed));
+    assert(replayed.failedCommands == commands);
+    assert(play_game(7, one.failedGame, replayed));
+}
+
+int main() {
+    test_check_transition();
+    test_reproducible();
+    test_detects_violation();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <cstdlib>      // std::strtoull
+                        // std::atoll
+#include <random>       // std::random_device
+
+// Usage: Step_12w [seed [games [threads]]]
+//        Step_12w --replay seed game
+
+int main(int argc, char* argv[]) {
+    if ((argc == 4) && (std::string{argv[1]} == "--replay")) {
+        auto const seed{std::strtoull(argv[2], nullptr, 0)};
+        StressResult result{};
+        bool const ok{play_game(seed, std::atoll(argv[3]), result,
+                                &std::cout)};
+        if (!ok)
+            std::cout << "*** VIOLATION: " << result.violation << '\n'
+                      << "    commands: " << result.failedCommands
+                      << std::endl;
+        return ok ? 0 : 1;
+    }
+    std::uint64_t const seed{(argc > 1)
+                                ? std::strtoull(argv[1], nullptr, 0)
+                                : std::random_device{}()};
+    long long const games{(argc > 2) ? std::atoll(argv[2]) : 1'000'000};
+    unsigned threads{std::max(1u, std::thread::hardware_concurrency())};
+    if (argc > 3)
+        threads = std::max(1, std::atoi(argv[3]));
+    auto const start{std::chrono::steady_clock::now()};
+    auto const result{stress(seed, games, threads)};
+    result.show(std::cout, seed, std::chrono::steady_clock::now() - start);
+    return (result.failedGame < 0) ? 0 : 1;
+}
+
+#endif
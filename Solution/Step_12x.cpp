@@ -0,0 +1,401 @@
+#include <cctype>   // std::islower
+                    // std::isdigit
+                    // std::tolower
+#include <iomanip>  // std::width
+                    // std::setfill
+#include <iostream> // std::cout
+                    // std::endl
+#include <string>   // std::string
+                    // std::to_string
+
+constexpr int InitialTime{30*60*10};
+
+class I_DownCounting {
+public:
+    virtual bool is_counting() const =0;
+    virtual void step() =0;
+};
+
+class BaseDownCounter : virtual public I_DownCounting {
+private:
+    int value_{};
+    const int reset_{};
+    virtual bool chained_is_counting() const { return false; }
+    virtual void chained_needs_step() {}
+public:
+    BaseDownCounter(int reset)
+        : reset_{reset}
+    {/*empty*/}
+    int get() const { return value_; }
+    void set(int);
+    bool is_counting() const final;
+    void step();
+};
+
+void BaseDownCounter::set(int value) {
+    value_ = (value >= reset_)
+                ? reset_-1
+                : value;
+}
+
+bool BaseDownCounter::is_counting() const {
+     return (value_ != 0)
+         || chained_is_counting();
+}
+
+void BaseDownCounter::step() {
+    if (value_ > 0)
+        --value_;
+    else {
+        if (chained_is_counting()) {
+            value_ = reset_-1;
+            chained_needs_step();
+        }
+    }
+}
+
+class ChainableDownCounter : public BaseDownCounter {
+    I_DownCounting& next_;
+public:
+    ChainableDownCounter(int limit, I_DownCounting& next)
+        : BaseDownCounter{limit}, next_{next}
+    {/*empty*/}
+    void chained_needs_step() override {
+        next_.step();
+    }
+    bool chained_is_counting() const override {
+        return next_.is_counting();
+    }
+};
+
+class Clock {
+private:
+    BaseDownCounter minutes_{1000};
+    ChainableDownCounter seconds_{60, minutes_};
+    ChainableDownCounter tenthsecs_{10, seconds_};
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+void Clock::set(int ts) {
+    tenthsecs_.set(ts % 10); ts /= 10;
+    seconds_.set(ts % 60); ts /= 60;
+    minutes_.set(ts);
+}
+
+int Clock::get() const {
+    return (minutes_.get()*60 + seconds_.get())*10 + tenthsecs_.get();
+}
+
+Clock::operator bool() const {
+        return tenthsecs_.is_counting();
+    }
+
+Clock& Clock::operator--() {
+    tenthsecs_.step();
+    return *this;
+}
+
+void Clock::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    os << setfill(' ') << setw(3) << minutes_.get() << ':'
+       << setfill('0') << setw(2) << seconds_.get() << '.'
+                       << setw(1) << tenthsecs_.get();
+    os.fill(saved_fill);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const Clock& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+// Replaying recorded games advances the clocks by up to 108'000 ticks
+// per command, hence (different from Step 12) the clock is not stepped
+// tick by tick but set to the remaining time at once.
+
+bool Clock::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+// --------------------------------------------------------------------
+// A chain of counters with any number of stages
+// --------------------------------------------------------------------
+// The class `Clock` above has three stages wired into it, and each of
+// them is a separate object, called through a virtual function for
+// every borrow. `mixed_radix::Clock` instead takes the list of stages
+// as template arguments (most significant first), eg.
+//
+//     mixed_radix::Clock<1000, 60, 10>      mmm:ss.t  (as `Clock`)
+//     mixed_radix::Clock<60, 60, 1000>      mm:ss.ttt (milliseconds)
+//     mixed_radix::Clock<100, 60, 60, 100>  hh:mm:ss.cc
+//
+// and keeps the values of all stages in one array. Stepping borrows
+// in a loop over the stages, while setting and subtracting many ticks
+// at once convert between the stages and the total number of ticks
+// (ie. mixed radix arithmetic). As the radix list is known at compile
+// time the loops are unrolled and the divisions become
+// multiplications.
+//
+// The behavior is the same as that of `Clock` above, including that
+// a value too large for the most significant stage is clamped there
+// (while the other stages keep the remainder), and the output is
+// formatted from the radix list: each stage as wide as its largest
+// value, separated by ':' and by '.' before the last one.
+
+#include <algorithm>    // std::min
+#include <array>        // std::array
+#include <cstddef>      // std::size_t
+#include <limits>       // std::numeric_limits
+
+namespace mixed_radix {
+
+constexpr int digits(int value) {
+    int n{1};
+    while (value >= 10) {
+        value /= 10;
+        ++n;
+    }
+    return n;
+}
+
+template<int... Radices>
+class Clock {
+    static_assert(sizeof...(Radices) > 0, "at least one stage required");
+    static_assert(((Radices > 1) && ...), "each radix must be at least 2");
+public:
+    static constexpr std::size_t Stages{sizeof...(Radices)};
+    static constexpr std::array<int, Stages> Radix{Radices...};
+    static constexpr long long Range{(1LL * ... * Radices)};
+    static_assert(Range - 1 <= std::numeric_limits<int>::max(),
+                  "number of ticks must fit into an int");
+    static constexpr int MaxTime{static_cast<int>(Range - 1)};
+private:
+    std::array<int, Stages> value_{}; // (most significant first)
+public:
+    Clock() =default; // no arguments C'tor (aka Default C'tor)
+    Clock(const Clock&)            =delete; // Copy-C'tor
+    Clock(Clock&&)                 =delete; // Move-C'tor
+    Clock& operator=(const Clock&) =delete; // Copy-Assign
+    Clock& operator=(Clock&&)      =delete; // Move-Assign
+    ~Clock() =default;
+
+    void set(int);
+    int get() const;
+    int stage(std::size_t i) const { return value_[i]; }
+    operator bool() const;
+    Clock& operator--();
+    bool operator-=(int);
+    void show(std::ostream& = std::cout) const;
+};
+
+template<int... Radices>
+void Clock<Radices...>::set(int ts) {
+    for (auto i{Stages - 1}; i > 0; --i) {
+        value_[i] = ts % Radix[i]; ts /= Radix[i];
+    }
+    value_[0] = std::min(ts, Radix[0] - 1);
+}
+
+template<int... Radices>
+int Clock<Radices...>::get() const {
+    int ts{value_[0]};
+    for (std::size_t i{1}; i < Stages; ++i)
+        ts = ts*Radix[i] + value_[i];
+    return ts;
+}
+
+template<int... Radices>
+Clock<Radices...>::operator bool() const {
+    for (auto i{Stages}; i-- > 0; ) // (least significant first)
+        if (value_[i] != 0)
+            return true;
+    return false;
+}
+
+template<int... Radices>
+Clock<Radices...>& Clock<Radices...>::operator--() {
+    if (value_[Stages - 1] > 0) { // (no borrow, by far the most frequent)
+        --value_[Stages - 1];
+        return *this;
+    }
+    for (auto i{Stages - 1}; i-- > 0; ) {
+        if (value_[i] > 0) {
+            --value_[i];
+            for (auto j{i + 1}; j < Stages; ++j)
+                value_[j] = Radix[j] - 1;
+            return *this;
+        }
+    }
+    return *this; // (all stages were zero, nothing to borrow from)
+}
+
+template<int... Radices>
+bool Clock<Radices...>::operator-=(int steps) {
+    if (steps <= 0)
+        return true;
+    auto const remaining{get()};
+    set((steps < remaining) ? remaining - steps : 0);
+    return (steps <= remaining);
+}
+
+template<int... Radices>
+void Clock<Radices...>::show(std::ostream& os) const {
+    auto const saved_fill{os.fill()};
+    using std::setw;
+    using std::setfill;
+    for (std::size_t i{}; i < Stages; ++i) {
+        if (i > 0)
+            os << ((i == Stages - 1) ? '.' : ':');
+        os << setfill((i == 0) ? ' ' : '0')
+           << setw(digits(Radix[i] - 1)) << value_[i];
+    }
+    os.fill(saved_fill);
+}
+
+template<int... Radices>
+std::ostream& operator<<(std::ostream& lhs, const Clock<Radices...>& rhs) {
+    rhs.show(lhs);
+    return lhs;
+}
+
+using TenthsClock = Clock<1000, 60, 10>;
+using BulletClock = Clock<60, 60, 1000>;
+using HoursClock = Clock<100, 60, 60, 100>;
+
+} // namespace mixed_radix
+
+#if 0
+
+#include <cassert>
+#include <sstream>
+
+template<typename C>
+std::string to_string(const C& clk) {
+    std::ostringstream os{};
+    os << clk;
+    return os.str();
+}
+
+// (the same sequence of borrows as `test_triple_stage` in Step 11)
+
+void test_triple_stage() {
+    mixed_radix::Clock<2, 2, 2> clk{};
+    clk.set(7);                 assert(to_string(clk) == "1:1.1");
+    --clk;                      assert(to_string(clk) == "1:1.0");
+    --clk;                      assert(to_string(clk) == "1:0.1");
+    --clk;                      assert(to_string(clk) == "1:0.0");
+    --clk;                      assert(to_string(clk) == "0:1.1");
+    --clk;                      assert(to_string(clk) == "0:1.0");
+    --clk;                      assert(to_string(clk) == "0:0.1");
+    --clk;                      assert(to_string(clk) == "0:0.0");
+    assert(!clk);
+    --clk;                      assert(to_string(clk) == "0:0.0");
+}
+
+void test_formatting() {
+    mixed_radix::BulletClock bullet{};
+    bullet.set(61'234);         assert(to_string(bullet) == " 1:01.234");
+    mixed_radix::HoursClock hours{};
+    hours.set(((1*60 + 2)*60 + 3)*100 + 4);
+                                assert(to_string(hours) == " 1:02:03.04");
+    assert(hours.stage(0) == 1); assert(hours.stage(3) == 4);
+    mixed_radix::Clock<10> single{};
+    single.set(7);              assert(to_string(single) == "7");
+}
+
+void test_same_as_chained_clock() {
+    ::Clock chained{};
+    mixed_radix::TenthsClock mixed{};
+    static_assert(mixed_radix::TenthsClock::MaxTime == 1000*60*10 - 1);
+    for (int v{}; v <= mixed_radix::TenthsClock::MaxTime + 10; ++v) {
+        chained.set(v); mixed.set(v);
+        assert(chained.get() == mixed.get());
+        assert(static_cast<bool>(chained) == static_cast<bool>(mixed));
+        --chained; --mixed;
+        assert(chained.get() == mixed.get());
+        for (int const n : {-1, 0, 1, 10, 600, v, v + 1}) {
+            chained.set(v); mixed.set(v);
+            assert((chained -= n) == (mixed -= n));
+            assert(chained.get() == mixed.get());
+        }
+        if (v % 997 == 0)
+            assert(to_string(chained) == to_string(mixed));
+    }
+}
+
+int main() {
+    test_triple_stage();
+    test_formatting();
+    test_same_as_chained_clock();
+    std::cout << "*** ALL TESTS PASSED ***" << std::endl;
+}
+
+#else
+
+#include <chrono>
+#include <cstdlib>      // std::atoi
+
+// Steps a clock from the given time down to zero and returns the
+// nanoseconds per step.
+
+template<typename C>
+double ns_per_step(C& clk, int from) {
+    clk.set(from);
+    auto const t0{std::chrono::steady_clock::now()};
+    long steps{};
+    while (clk) {
+        --clk;
+        ++steps;
+    }
+    auto const t1{std::chrono::steady_clock::now()};
+    std::chrono::duration<double, std::nano> const elapsed{t1 - t0};
+    return elapsed.count() / steps;
+}
+
+// Usage: Step_12x [minutes]
+
+int main(int argc, char* argv[]) {
+    int const minutes{(argc > 1) ? std::max(1, std::atoi(argv[1])) : 30};
+    ::Clock chained{};
+    mixed_radix::TenthsClock tenths{};
+    mixed_radix::BulletClock bullet{};
+    mixed_radix::HoursClock hours{};
+    chained.set(minutes*60*10);
+    tenths.set(minutes*60*10);
+    bullet.set(minutes*60*1000);
+    hours.set(minutes*60*100);
+    std::cout << "chained Clock<1000,60,10>:   " << chained << '\n'
+              << "mixed_radix<1000,60,10>:     " << tenths << '\n'
+              << "mixed_radix<60,60,1000>:     " << bullet << '\n'
+              << "mixed_radix<100,60,60,100>:  " << hours << '\n';
+    std::cout << "--- ns per step, counting " << minutes
+              << " minutes down to zero\n"
+              << "chained Clock<1000,60,10>:   "
+              << ns_per_step(chained, minutes*60*10) << '\n'
+              << "mixed_radix<1000,60,10>:     "
+              << ns_per_step(tenths, minutes*60*10) << '\n'
+              << "mixed_radix<60,60,1000>:     "
+              << ns_per_step(bullet, minutes*60*1000) << '\n'
+              << "mixed_radix<100,60,60,100>:  "
+              << ns_per_step(hours, minutes*60*100) << std::endl;
+}
+
+#endif